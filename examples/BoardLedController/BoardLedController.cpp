@@ -5,6 +5,7 @@
 // Peter Polidoro peter@polidoro.io
 // ----------------------------------------------------------------------------
 #include "BoardLedController.h"
+#include "ElementTables.h"
 
 
 void BoardLedController::setup()
@@ -34,7 +35,8 @@ void BoardLedController::setup()
     properties_,
     parameters_,
     functions_,
-    callbacks_);
+    callbacks_,
+    constants::element_tables);
 
   // Properties
 
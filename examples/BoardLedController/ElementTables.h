@@ -0,0 +1,44 @@
+// ----------------------------------------------------------------------------
+// ElementTables.h
+//
+// Generated from examples/BoardLedController/api/BoardLedController.json
+// by tools/generate_element_tables.py, do not edit.
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef BOARD_LED_CONTROLLER_ELEMENT_TABLES_H
+#define BOARD_LED_CONTROLLER_ELEMENT_TABLES_H
+#include "Constants.h"
+
+
+namespace constants
+{
+const uint32_t parameter_name_hashes[] PROGMEM =
+{
+  0x39B1DDF4UL, // count
+  0x45EB430FUL, // duration_on
+  0x6A6E8CD3UL // duration_off
+};
+
+const uint32_t function_name_hashes[] PROGMEM =
+{
+  0x4DBFC03EUL, // blinkLed
+  0xBA520F36UL, // getLedPinNumber
+  0xF4DDD1A9UL, // setLedOff
+  0xF5FAE1CDUL // setLedOn
+};
+
+const modular_server::ElementTables element_tables =
+{
+  NULL,
+  0,
+  parameter_name_hashes,
+  3,
+  function_name_hashes,
+  4,
+  NULL,
+  0
+};
+}
+#endif
@@ -5,6 +5,7 @@
 // Peter Polidoro peter@polidoro.io
 // ----------------------------------------------------------------------------
 #include "CallbackTester.h"
+#include "ElementTables.h"
 
 
 void CallbackTester::setup()
@@ -52,18 +53,19 @@ void CallbackTester::setup()
     properties_,
     parameters_,
     functions_,
-    callbacks_);
+    callbacks_,
+    constants::element_tables);
 
   // Properties
-  modular_server::Property & duration_on_property = modular_server_.createProperty(constants::duration_on_property_name,constants::duration_on_default);
+  modular_server::Property & duration_on_property = modular_server_.createProperty(constants::duration_on_property_name,constants::duration_on_default,duration_on_property_);
   duration_on_property.setUnits(constants::seconds_unit);
   duration_on_property.setRange(constants::duration_min,constants::duration_max);
 
-  modular_server::Property & duration_off_property = modular_server_.createProperty(constants::duration_off_property_name,constants::duration_off_default);
+  modular_server::Property & duration_off_property = modular_server_.createProperty(constants::duration_off_property_name,constants::duration_off_default,duration_off_property_);
   duration_off_property.setUnits(constants::seconds_unit);
   duration_off_property.setRange(constants::duration_min,constants::duration_max);
 
-  modular_server::Property & count_property = modular_server_.createProperty(constants::count_property_name,constants::count_default);
+  modular_server::Property & count_property = modular_server_.createProperty(constants::count_property_name,constants::count_default,count_property_);
   count_property.setRange(constants::count_min,constants::count_max);
 
   // Parameters
@@ -120,11 +122,14 @@ void CallbackTester::setLedOffHandler(modular_server::Pin * pin_ptr)
 void CallbackTester::blinkLedHandler(modular_server::Pin * pin_ptr)
 {
   double duration_on;
-  modular_server_.property(constants::duration_on_property_name).getValue(duration_on);
   double duration_off;
-  modular_server_.property(constants::duration_off_property_name).getValue(duration_off);
   long count;
-  modular_server_.property(constants::count_property_name).getValue(count);
+  if (!duration_on_property_.getValue(duration_on) ||
+    !duration_off_property_.getValue(duration_off) ||
+    !count_property_.getValue(count))
+  {
+    return;
+  }
   blinker_.stop();
   blinker_.setDurationOn(duration_on);
   blinker_.setDurationOff(duration_off);
@@ -30,6 +30,10 @@ private:
   modular_server::Function functions_[constants::FUNCTION_COUNT_MAX];
   modular_server::Callback callbacks_[constants::CALLBACK_COUNT_MAX];
 
+  modular_server::PropertyHandle<double> duration_on_property_;
+  modular_server::PropertyHandle<double> duration_off_property_;
+  modular_server::PropertyHandle<long> count_property_;
+
   Blinker blinker_;
 
   // Handlers
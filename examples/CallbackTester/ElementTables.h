@@ -0,0 +1,43 @@
+// ----------------------------------------------------------------------------
+// ElementTables.h
+//
+// Generated from examples/CallbackTester/api/CallbackTester.json
+// by tools/generate_element_tables.py, do not edit.
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef CALLBACK_TESTER_ELEMENT_TABLES_H
+#define CALLBACK_TESTER_ELEMENT_TABLES_H
+#include "Constants.h"
+
+
+namespace constants
+{
+const uint32_t property_name_hashes[] PROGMEM =
+{
+  0x39B1DDF4UL, // count
+  0xAA8C71F8UL, // durationOn
+  0xE9030872UL // durationOff
+};
+
+const uint32_t callback_name_hashes[] PROGMEM =
+{
+  0x4DBFC03EUL, // blinkLed
+  0xF4DDD1A9UL, // setLedOff
+  0xF5FAE1CDUL // setLedOn
+};
+
+const modular_server::ElementTables element_tables =
+{
+  property_name_hashes,
+  3,
+  NULL,
+  0,
+  NULL,
+  0,
+  callback_name_hashes,
+  3
+};
+}
+#endif
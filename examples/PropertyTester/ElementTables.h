@@ -0,0 +1,76 @@
+// ----------------------------------------------------------------------------
+// ElementTables.h
+//
+// Generated from examples/PropertyTester/api/PropertyTester.json
+// by tools/generate_element_tables.py, do not edit.
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef PROPERTY_TESTER_ELEMENT_TABLES_H
+#define PROPERTY_TESTER_ELEMENT_TABLES_H
+#include "Constants.h"
+
+
+namespace constants
+{
+const uint32_t property_name_hashes[] PROGMEM =
+{
+  0x15C972F3UL, // modeArray
+  0x17C16538UL, // string
+  0x20B10B5EUL, // boolArray
+  0xA0EB0F08UL, // double
+  0xAD409D5EUL, // odd
+  0xAF5C9727UL, // oddArray
+  0xC894953DUL, // bool
+  0xEC6EE012UL, // mode
+  0xF3CCE5C8UL, // longArray
+  0xF762E745UL // doubleArray
+};
+
+const uint32_t parameter_name_hashes[] PROGMEM =
+{
+  0x39B1DDF4UL, // count
+  0x3CFF2FECUL, // direction_array
+  0x8C316A99UL, // length_parameter
+  0xAEABBBBAUL, // count_array
+  0xBB469CE5UL, // long_array_parameter
+  0xDF6DC76AUL, // direction
+  0xF354CAC0UL // subset_index
+};
+
+const uint32_t function_name_hashes[] PROGMEM =
+{
+  0x194206EEUL, // getCount
+  0x22A8C616UL, // setNewOddSubset
+  0x2FEDC085UL, // incrementMode
+  0x3D5E8DF9UL, // getStringAll
+  0x48249B03UL, // getBool
+  0x641498D4UL, // getLongArrayFixed
+  0x7284BD68UL, // setLongArrayFixed
+  0x731C0220UL, // getDirection
+  0x8A82CAEBUL, // setNewDoubleRange
+  0x8C30ABBEUL, // getLongArrayVariable
+  0x9878C88AUL, // getStringSome
+  0xAC9C3F59UL, // setLongArrayParameter
+  0xB9E7609DUL, // getDirectionArray
+  0xBB780CF7UL, // getCountArray
+  0xCE91E7A0UL, // checkMode
+  0xD2E17C4AUL, // setLongArrayVariable
+  0xE7729AB1UL, // setNewOddDefault
+  0xEE29C08AUL // getDoubled
+};
+
+const modular_server::ElementTables element_tables =
+{
+  property_name_hashes,
+  10,
+  parameter_name_hashes,
+  7,
+  function_name_hashes,
+  18,
+  NULL,
+  0
+};
+}
+#endif
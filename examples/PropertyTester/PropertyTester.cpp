@@ -5,6 +5,7 @@
 // Peter Polidoro peter@polidoro.io
 // ----------------------------------------------------------------------------
 #include "PropertyTester.h"
+#include "ElementTables.h"
 
 
 void PropertyTester::setup()
@@ -32,7 +33,8 @@ void PropertyTester::setup()
     properties_,
     parameters_,
     functions_,
-    callbacks_);
+    callbacks_,
+    constants::element_tables);
 
   // Properties
   modular_server::Property & double_property = modular_server_.createProperty(constants::double_property_name,constants::double_default);
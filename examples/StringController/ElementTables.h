@@ -0,0 +1,56 @@
+// ----------------------------------------------------------------------------
+// ElementTables.h
+//
+// Generated from examples/StringController/api/StringController.json
+// by tools/generate_element_tables.py, do not edit.
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef STRING_CONTROLLER_ELEMENT_TABLES_H
+#define STRING_CONTROLLER_ELEMENT_TABLES_H
+#include "Constants.h"
+
+
+namespace constants
+{
+const uint32_t property_name_hashes[] PROGMEM =
+{
+  0x4DDEBB65UL, // startingCharsCount
+  0x76AE5F0FUL // storedString
+};
+
+const uint32_t parameter_name_hashes[] PROGMEM =
+{
+  0x015FC774UL, // double_echo
+  0x17C16538UL, // string
+  0x39B1DDF4UL, // count
+  0x630B0811UL, // index_array
+  0x6F720EBEUL // string2
+};
+
+const uint32_t function_name_hashes[] PROGMEM =
+{
+  0x21423B56UL, // startingChars
+  0x67D136FFUL, // charsAt
+  0x83D03615UL, // length
+  0xC95A6A91UL, // setStoredString
+  0xD49DD484UL, // echo
+  0xD99BA82AUL, // repeat
+  0xF2517F5DUL, // getStoredString
+  0xFBA460FCUL // startsWith
+};
+
+const modular_server::ElementTables element_tables =
+{
+  property_name_hashes,
+  2,
+  parameter_name_hashes,
+  5,
+  function_name_hashes,
+  8,
+  NULL,
+  0
+};
+}
+#endif
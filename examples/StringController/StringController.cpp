@@ -5,6 +5,7 @@
 // Peter Polidoro peter@polidoro.io
 // ----------------------------------------------------------------------------
 #include "StringController.h"
+#include "ElementTables.h"
 
 
 void StringController::setup()
@@ -32,7 +33,8 @@ void StringController::setup()
     properties_,
     parameters_,
     functions_,
-    callbacks_);
+    callbacks_,
+    constants::element_tables);
 
   // Properties
   modular_server::Property & serial_number_property = modular_server_.property(modular_server::constants::serial_number_property_name);
@@ -46,6 +48,7 @@ void StringController::setup()
   // Parameters
   modular_server::Parameter & string_parameter = modular_server_.createParameter(constants::string_parameter_name);
   string_parameter.setTypeString();
+  string_parameter_ptr_ = &string_parameter;
 
   modular_server::Parameter & string2_parameter = modular_server_.copyParameter(string_parameter,constants::string2_parameter_name);
 
@@ -58,6 +61,7 @@ void StringController::setup()
 
   modular_server::Parameter & double_echo_parameter = modular_server_.createParameter(constants::double_echo_parameter_name);
   double_echo_parameter.setTypeBool();
+  double_echo_parameter_ptr_ = &double_echo_parameter;
 
   modular_server::Parameter & array_to_echo_parameter = modular_server_.createParameter(constants::array_to_echo_parameter_name);
   array_to_echo_parameter.setArrayLengthRange(constants::array_to_echo_length_min,constants::array_to_echo_length_max);
@@ -70,19 +74,19 @@ void StringController::setup()
   echo_function.setResultTypeString();
 
   modular_server::Function & length_function = modular_server_.createFunction(constants::length_function_name);
-  length_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&StringController::lengthHandler));
+  length_function.attachFunctor(makeFunctor((Functor1<const char *> *)0,*this,&StringController::lengthHandler));
   length_function.addParameter(string_parameter);
   length_function.setResultTypeLong();
   length_function.setResultUnits(constants::characters_units);
 
   modular_server::Function & starts_with_function = modular_server_.createFunction(constants::starts_with_function_name);
-  starts_with_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&StringController::startsWithHandler));
+  starts_with_function.attachFunctor(makeFunctor((Functor2<const char *,const char *> *)0,*this,&StringController::startsWithHandler));
   starts_with_function.addParameter(string_parameter);
   starts_with_function.addParameter(string2_parameter);
   starts_with_function.setResultTypeBool();
 
   modular_server::Function & repeat_function = modular_server_.createFunction(constants::repeat_function_name);
-  repeat_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&StringController::repeatHandler));
+  repeat_function.attachFunctor(makeFunctor((Functor2<const char *,long> *)0,*this,&StringController::repeatHandler));
   repeat_function.addParameter(string_parameter);
   repeat_function.addParameter(count_parameter);
   repeat_function.setResultTypeArray();
@@ -134,9 +138,9 @@ void StringController::update()
 void StringController::echoHandler()
 {
   const char * string;
-  modular_server_.parameter(constants::string_parameter_name).getValue(string);
+  string_parameter_ptr_->getValue(string);
   bool double_echo = false;
-  modular_server_.parameter(constants::double_echo_parameter_name).getValue(double_echo);
+  double_echo_parameter_ptr_->getValue(double_echo);
   modular_server::Response & response = modular_server_.response();
   if (!double_echo)
   {
@@ -149,28 +153,20 @@ void StringController::echoHandler()
   }
 }
 
-void StringController::lengthHandler()
+void StringController::lengthHandler(const char * string)
 {
-  const char * string;
-  modular_server_.parameter(constants::string_parameter_name).getValue(string);
   modular_server_.response().returnResult(strlen(string));
 }
 
-void StringController::startsWithHandler()
+void StringController::startsWithHandler(const char * string,
+  const char * string2)
 {
-  const char * string;
-  modular_server_.parameter(constants::string_parameter_name).getValue(string);
-  const char * string2;
-  modular_server_.parameter(constants::string2_parameter_name).getValue(string2);
   modular_server_.response().returnResult((bool)String(string).startsWith(string2));
 }
 
-void StringController::repeatHandler()
+void StringController::repeatHandler(const char * string,
+  long count)
 {
-  const char * string;
-  modular_server_.parameter(constants::string_parameter_name).getValue(string);
-  long count = 0;
-  modular_server_.parameter(constants::count_parameter_name).getValue(count);
   modular_server::Response & response = modular_server_.response();
   response.writeResultKey();
   response.beginArray();
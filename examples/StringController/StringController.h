@@ -29,11 +29,17 @@ private:
   modular_server::Function functions_[constants::FUNCTION_COUNT_MAX];
   modular_server::Callback callbacks_[constants::CALLBACK_COUNT_MAX];
 
+  // parameters kept from setup are read without a name lookup
+  modular_server::Parameter * string_parameter_ptr_;
+  modular_server::Parameter * double_echo_parameter_ptr_;
+
   // Handlers
   void echoHandler();
-  void lengthHandler();
-  void startsWithHandler();
-  void repeatHandler();
+  void lengthHandler(const char * string);
+  void startsWithHandler(const char * string,
+    const char * string2);
+  void repeatHandler(const char * string,
+    long count);
   void charsAtHandler();
   void startingCharsHandler();
   void setStoredStringHandler();
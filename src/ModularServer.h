@@ -14,6 +14,7 @@ namespace modular_server
 {
 using FirmwareInfo = constants::FirmwareInfo;
 using HardwareInfo = constants::HardwareInfo;
+using ElementTables = constants::ElementTables;
 using SubsetMemberType = constants::SubsetMemberType;
 
 class ModularServer
@@ -23,7 +24,9 @@ public:
   void setup();
 
   // Streams
-  void addServerStream(Stream & stream);
+  ServerStream & addServerStream(Stream & stream);
+  ServerStream & serverStream(Stream & stream);
+  void setRequestsPerCallMax(size_t requests_per_call_max);
 
   // Device ID
   void setDeviceName(const ConstantString & device_name);
@@ -50,6 +53,16 @@ public:
     Parameter (&parameters)[PARAMETERS_MAX_SIZE],
     Function (&functions)[FUNCTIONS_MAX_SIZE],
     Callback (&callbacks)[CALLBACKS_MAX_SIZE]);
+  template <size_t PROPERTIES_MAX_SIZE,
+    size_t PARAMETERS_MAX_SIZE,
+    size_t FUNCTIONS_MAX_SIZE,
+    size_t CALLBACKS_MAX_SIZE>
+  void addFirmware(const FirmwareInfo & firmware_info,
+    Property (&properties)[PROPERTIES_MAX_SIZE],
+    Parameter (&parameters)[PARAMETERS_MAX_SIZE],
+    Function (&functions)[FUNCTIONS_MAX_SIZE],
+    Callback (&callbacks)[CALLBACKS_MAX_SIZE],
+    const ElementTables & element_tables);
 
   // Properties
   template <typename T>
@@ -59,6 +72,15 @@ public:
     size_t N>
   Property & createProperty(const ConstantString & property_name,
     const T (&default_value)[N]);
+  template <typename T>
+  Property & createProperty(const ConstantString & property_name,
+    const T & default_value,
+    PropertyHandle<T> & property_handle);
+  template <typename T,
+    size_t N>
+  Property & createProperty(const ConstantString & property_name,
+    const T (&default_value)[N],
+    PropertyHandle<T[N]> & property_handle);
   Property & property(const ConstantString & property_name);
   template <typename T>
   void setPropertiesToDefaults(T & firmware_name_array);
@@ -86,6 +108,8 @@ public:
   void startServer();
   void stopServer();
   void handleServerRequests();
+  void enableStableMethodIds();
+  void disableStableMethodIds();
 
 private:
   Server server_;
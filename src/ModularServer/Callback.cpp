@@ -26,14 +26,22 @@ constants::SubsetMemberType pin_mode_ptr_subset[PIN_MODE_SUBSET_LENGTH] =
 CONSTANT_STRING(trigger_function_name,"trigger");
 CONSTANT_STRING(attach_to_function_name,"attachTo");
 CONSTANT_STRING(detach_from_function_name,"detachFrom");
+
+const ConstantString * const function_id_names[FUNCTION_COUNT_MAX] =
+{
+  &trigger_function_name,
+  &attach_to_function_name,
+  &detach_from_function_name,
+};
 }
 
 Array<Parameter,callback::PARAMETER_COUNT_MAX> Callback::parameters_;
 Array<Function,callback::FUNCTION_COUNT_MAX> Callback::functions_;
+Callback * Callback::functions_callback_ptr_ = NULL;
 Array<constants::SubsetMemberType,constants::PIN_COUNT_MAX+1> * Callback::pin_name_array_ptr_;
+SubsetIndex * Callback::pin_name_subset_index_ptr_ = NULL;
 Functor1wRet<const char *,Pin *> Callback::find_pin_ptr_by_chars_functor_;
 Functor1wRet<const ConstantString &,Pin *> Callback::find_pin_ptr_by_constant_string_functor_;
-Functor1wRet<const ConstantString &,ArduinoJson::JsonVariant> Callback::get_parameter_value_functor_;
 
 Parameter & Callback::createParameter(const ConstantString & parameter_name)
 {
@@ -369,6 +377,10 @@ Callback::Callback(const ConstantString & name)
 void Callback::setup(const ConstantString & name)
 {
   setName(name);
+  if (functions_callback_ptr_ == this)
+  {
+    functions_callback_ptr_ = NULL;
+  }
 }
 
 int Callback::findPropertyIndex(const ConstantString & property_name)
@@ -450,15 +462,43 @@ void Callback::functor(Pin * pin_ptr)
 }
 
 void Callback::updateFunctionsAndParameters()
+{
+  // every callback shares the same function table, so it is built once and
+  // only rebound when a different callback is requested
+  if (functions_.size() == 0)
+  {
+    buildFunctionsAndParameters();
+    functions_callback_ptr_ = NULL;
+  }
+  if (functions_callback_ptr_ != this)
+  {
+    bindFunctions();
+    functions_callback_ptr_ = this;
+  }
+
+  // pins may be created after the table is built, the server keeps the
+  // shared pin name index current so only the subset size needs following
+  Parameter & pin_name_parameter = parameters_[callback::PIN_NAME_PARAMETER_ID];
+  if (!pin_name_parameter.subsetIsSet() ||
+    (pin_name_parameter.getSubsetSize() != pin_name_array_ptr_->size()))
+  {
+    pin_name_parameter.setSubset(pin_name_array_ptr_->data(),
+      pin_name_array_ptr_->max_size(),
+      pin_name_array_ptr_->size());
+  }
+}
+
+void Callback::buildFunctionsAndParameters()
 {
   // Parameters
   parameters_.clear();
 
   Parameter & pin_name_parameter = createParameter(constants::pin_name_parameter_name);
   pin_name_parameter.setTypeString();
-  pin_name_parameter.setSubset(pin_name_array_ptr_->data(),
-    pin_name_array_ptr_->max_size(),
-    pin_name_array_ptr_->size());
+  if (pin_name_subset_index_ptr_)
+  {
+    pin_name_parameter.setSubsetIndex(*pin_name_subset_index_ptr_);
+  }
 
   Parameter & pin_mode_parameter = createParameter(constants::pin_mode_constant_string);
   pin_mode_parameter.setTypeString();
@@ -467,19 +507,28 @@ void Callback::updateFunctionsAndParameters()
   // Functions
   functions_.clear();
 
-  Function & trigger_function = createFunction(callback::trigger_function_name);
-  trigger_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Callback::triggerHandler));
+  createFunction(callback::trigger_function_name);
 
   Function & attach_to_function = createFunction(callback::attach_to_function_name);
-  attach_to_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Callback::attachToHandler));
   attach_to_function.addParameter(pin_name_parameter);
   attach_to_function.addParameter(pin_mode_parameter);
 
   Function & detach_from_function = createFunction(callback::detach_from_function_name);
-  detach_from_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Callback::detachFromHandler));
   detach_from_function.addParameter(pin_name_parameter);
 }
 
+void Callback::bindFunctions()
+{
+  Function & trigger_function = functions_[callback::TRIGGER_FUNCTION_ID];
+  trigger_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Callback::triggerHandler));
+
+  Function & attach_to_function = functions_[callback::ATTACH_TO_FUNCTION_ID];
+  attach_to_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Callback::attachToHandler));
+
+  Function & detach_from_function = functions_[callback::DETACH_FROM_FUNCTION_ID];
+  detach_from_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Callback::detachFromHandler));
+}
+
 void Callback::triggerHandler()
 {
   functor(NULL);
@@ -487,14 +536,14 @@ void Callback::triggerHandler()
 
 void Callback::attachToHandler()
 {
-  const char * pin_name = get_parameter_value_functor_(constants::pin_name_parameter_name);
-  const char * pin_mode = get_parameter_value_functor_(constants::pin_mode_constant_string);
+  const char * pin_name = parameters_[callback::PIN_NAME_PARAMETER_ID].getRequestString();
+  const char * pin_mode = parameters_[callback::PIN_MODE_PARAMETER_ID].getRequestString();
   attachTo(pin_name,pin_mode);
 }
 
 void Callback::detachFromHandler()
 {
-  const char * pin_str = get_parameter_value_functor_(constants::pin_name_parameter_name);
+  const char * pin_str = parameters_[callback::PIN_NAME_PARAMETER_ID].getRequestString();
   detachFrom(pin_str);
 }
 
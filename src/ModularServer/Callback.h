@@ -37,6 +37,20 @@ extern constants::SubsetMemberType pin_mode_ptr_subset[PIN_MODE_SUBSET_LENGTH];
 extern ConstantString trigger_function_name;
 extern ConstantString attach_to_function_name;
 extern ConstantString detach_from_function_name;
+
+// Function ids are positions in the function table
+extern const ConstantString * const function_id_names[FUNCTION_COUNT_MAX];
+enum FunctionId
+{
+  TRIGGER_FUNCTION_ID,
+  ATTACH_TO_FUNCTION_ID,
+  DETACH_FROM_FUNCTION_ID,
+};
+enum ParameterId
+{
+  PIN_NAME_PARAMETER_ID,
+  PIN_MODE_PARAMETER_ID,
+};
 }
 
 class Pin;
@@ -73,11 +87,12 @@ public:
 private:
   static Array<Parameter,callback::PARAMETER_COUNT_MAX> parameters_;
   static Array<Function,callback::FUNCTION_COUNT_MAX> functions_;
+  static Callback * functions_callback_ptr_;
   static Array<constants::SubsetMemberType,constants::PIN_COUNT_MAX+1> * pin_name_array_ptr_;
+  static SubsetIndex * pin_name_subset_index_ptr_;
   static Functor1wRet<const char *,Pin *> find_pin_ptr_by_chars_functor_;
   static Functor1wRet<const ConstantString &,Pin *> find_pin_ptr_by_constant_string_functor_;
   static Functor1wRet<const char *,Pin *> find_pin_ptr_functor_;
-  static Functor1wRet<const ConstantString &,ArduinoJson::JsonVariant> get_parameter_value_functor_;
 
   template <typename T>
   static int findParameterIndex(T const & parameter_name)
@@ -128,6 +143,8 @@ private:
   int findPinPtrIndex(const char * pin_name);
   void functor(Pin * pin_ptr);
   void updateFunctionsAndParameters();
+  static void buildFunctionsAndParameters();
+  void bindFunctions();
 
   // Handlers
   void triggerHandler();
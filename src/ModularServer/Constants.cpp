@@ -25,6 +25,18 @@ const long response_pipe_read_max = 100000;
 
 const double epsilon = 0.000000001;
 
+// Streams
+const size_t server_stream_byte_budget_default = 64;
+const size_t server_stream_weight_default = 1;
+const size_t server_stream_output_buffer_size_default = SERVER_STREAM_OUTPUT_BUFFER_SIZE_MAX;
+const size_t requests_per_call_max_default = 4;
+
+// Methods
+const uint32_t method_id_hash_multiplier = 2654435761UL;
+
+// Firmware
+const FirmwareMask firmware_mask_all = ~0;
+
 // Pins
 const size_t pin_pulse_timer_number = 3;
 const uint32_t pin_pulse_delay = 5;
@@ -79,6 +91,16 @@ CONSTANT_STRING(pin_value_parameter_name,"pin_value");
 const long pin_value_min = 0;
 const long pin_value_max = 255;
 
+CONSTANT_STRING(api_hash_parameter_name,"api_hash");
+
+CONSTANT_STRING(cursor_parameter_name,"cursor");
+const long cursor_min = 0;
+const long cursor_max = 65535;
+
+CONSTANT_STRING(page_size_parameter_name,"page_size");
+const long page_size_min = 1;
+const long page_size_max = 255;
+
 // Functions
 CONSTANT_STRING(get_method_ids_function_name,"getMethodIds");
 CONSTANT_STRING(help_function_name,"?");
@@ -86,14 +108,19 @@ CONSTANT_STRING(verbose_help_function_name,"??");
 CONSTANT_STRING(get_device_id_function_name,"getDeviceId");
 CONSTANT_STRING(get_device_info_function_name,"getDeviceInfo");
 CONSTANT_STRING(get_api_function_name,"getApi");
+CONSTANT_STRING(get_api_hash_function_name,"getApiHash");
+CONSTANT_STRING(get_api_if_changed_function_name,"getApiIfChanged");
+CONSTANT_STRING(get_api_page_function_name,"getApiPage");
 CONSTANT_STRING(get_property_default_values_function_name,"getPropertyDefaultValues");
 CONSTANT_STRING(set_properties_to_defaults_function_name,"setPropertiesToDefaults");
 CONSTANT_STRING(get_property_values_function_name,"getPropertyValues");
+CONSTANT_STRING(get_property_values_page_function_name,"getPropertyValuesPage");
 CONSTANT_STRING(get_pin_info_function_name,"getPinInfo");
 CONSTANT_STRING(set_pin_mode_function_name,"setPinMode");
 CONSTANT_STRING(get_pin_value_function_name,"getPinValue");
 CONSTANT_STRING(set_pin_value_function_name,"setPinValue");
 CONSTANT_STRING(get_memory_free_function_name,"getMemoryFree");
+CONSTANT_STRING(get_function_ids_function_name,"getFunctionIds");
 
 // Callbacks
 
@@ -106,6 +133,7 @@ CONSTANT_STRING(server_error_error_message,"Server error");
 
 CONSTANT_STRING(object_request_error_data,"JSON object requests not supported. Must use compact JSON array format for requests.");
 CONSTANT_STRING(request_length_error_data,"Request length too long.");
+CONSTANT_STRING(function_handler_parameters_error_data,"Function handler arguments do not match function parameters.");
 CONSTANT_STRING(parameter_not_found_error_data,"Parameter not found");
 CONSTANT_STRING(parameter_incorrect_type_error_data," parameter has incorrect type.");
 CONSTANT_STRING(property_not_found_error_data,"Property not found");
@@ -159,6 +187,8 @@ CONSTANT_STRING(function_constant_string,"function");
 CONSTANT_STRING(functions_constant_string,"functions");
 CONSTANT_STRING(callback_constant_string,"callback");
 CONSTANT_STRING(callbacks_constant_string,"callbacks");
+CONSTANT_STRING(property_functions_constant_string,"property_functions");
+CONSTANT_STRING(callback_functions_constant_string,"callback_functions");
 CONSTANT_STRING(min_constant_string,"min");
 CONSTANT_STRING(max_constant_string,"max");
 CONSTANT_STRING(array_element_min_constant_string,"array_element_min");
@@ -171,6 +201,9 @@ CONSTANT_STRING(part_number_constant_string,"part_number");
 CONSTANT_STRING(device_id_constant_string,"device_id");
 CONSTANT_STRING(device_info_constant_string,"device_info");
 CONSTANT_STRING(api_constant_string,"api");
+CONSTANT_STRING(unchanged_constant_string,"unchanged");
+CONSTANT_STRING(cursor_constant_string,"cursor");
+CONSTANT_STRING(values_constant_string,"values");
 CONSTANT_STRING(verbosity_constant_string,"verbosity");
 CONSTANT_STRING(value_constant_string,"value");
 CONSTANT_STRING(default_value_constant_string,"default_value");
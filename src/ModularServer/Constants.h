@@ -18,12 +18,15 @@ namespace modular_server
 namespace constants
 {
 enum {FIRMWARE_COUNT_MAX=8};
+// one bit per firmware
+typedef uint8_t FirmwareMask;
+static_assert(FIRMWARE_COUNT_MAX <= (8*sizeof(FirmwareMask)),"FirmwareMask too small for FIRMWARE_COUNT_MAX");
 enum {HARDWARE_COUNT_MAX=4};
 
 //MAX values must be >= 1, >= created/copied count, < RAM limit
 enum{SERVER_PROPERTY_COUNT_MAX=1};
-enum{SERVER_PARAMETER_COUNT_MAX=5};
-enum{SERVER_FUNCTION_COUNT_MAX=14};
+enum{SERVER_PARAMETER_COUNT_MAX=8};
+enum{SERVER_FUNCTION_COUNT_MAX=19};
 enum{SERVER_CALLBACK_COUNT_MAX=1};
 
 enum {FUNCTION_PARAMETER_COUNT_MAX=8};
@@ -32,6 +35,86 @@ enum {CALLBACK_PIN_COUNT_MAX=8};
 enum {PIN_COUNT_MAX=64};
 
 enum{SERVER_STREAM_COUNT_MAX=4};
+#if defined(__AVR__)
+enum{SERVER_STREAM_OUTPUT_BUFFER_SIZE_MAX=32};
+#else
+enum{SERVER_STREAM_OUTPUT_BUFFER_SIZE_MAX=512};
+#endif
+
+// flat element indexes, elements past these counts are still found through
+// the concatenated arrays, just more slowly
+#if defined(__AVR__)
+enum{PROPERTY_INDEX_SIZE=32};
+enum{PARAMETER_INDEX_SIZE=32};
+enum{FUNCTION_INDEX_SIZE=48};
+enum{CALLBACK_INDEX_SIZE=8};
+#else
+enum{PROPERTY_INDEX_SIZE=64};
+enum{PARAMETER_INDEX_SIZE=96};
+enum{FUNCTION_INDEX_SIZE=96};
+enum{CALLBACK_INDEX_SIZE=16};
+#endif
+
+// stable method ids, one for each function, callback and property in the
+// flat indexes. The id index must be a power of two and at least 4/3 of the
+// method count, so it is rounded up from the count
+constexpr size_t hashIndexSize(size_t count)
+{
+  size_t size = 1;
+  while ((size*3) < (count*4))
+  {
+    size <<= 1;
+  }
+  return size;
+}
+enum{METHOD_COUNT_MAX=FUNCTION_INDEX_SIZE+CALLBACK_INDEX_SIZE+PROPERTY_INDEX_SIZE};
+enum{METHOD_INDEX_SIZE=hashIndexSize(METHOD_COUNT_MAX)};
+
+// name hash indexes over the flat element indexes, each must be a power of
+// two. Elements named in the flash element tables are found through those
+// instead, so on AVR these only cover elements missing from the tables and
+// the rest are found by searching
+#if defined(__AVR__)
+enum{PIN_NAME_INDEX_SIZE=16};
+enum{PROPERTY_NAME_INDEX_SIZE=16};
+enum{PARAMETER_NAME_INDEX_SIZE=16};
+enum{FUNCTION_NAME_INDEX_SIZE=16};
+enum{CALLBACK_NAME_INDEX_SIZE=8};
+#else
+enum{PIN_NAME_INDEX_SIZE=128};
+enum{PROPERTY_NAME_INDEX_SIZE=128};
+enum{PARAMETER_NAME_INDEX_SIZE=128};
+enum{FUNCTION_NAME_INDEX_SIZE=128};
+enum{CALLBACK_NAME_INDEX_SIZE=32};
+static_assert(PIN_NAME_INDEX_SIZE*3 >= PIN_COUNT_MAX*4,"PIN_NAME_INDEX_SIZE too small for PIN_COUNT_MAX");
+static_assert(PROPERTY_NAME_INDEX_SIZE*3 >= PROPERTY_INDEX_SIZE*4,"PROPERTY_NAME_INDEX_SIZE too small for PROPERTY_INDEX_SIZE");
+static_assert(PARAMETER_NAME_INDEX_SIZE*3 >= PARAMETER_INDEX_SIZE*4,"PARAMETER_NAME_INDEX_SIZE too small for PARAMETER_INDEX_SIZE");
+static_assert(FUNCTION_NAME_INDEX_SIZE*3 >= FUNCTION_INDEX_SIZE*4,"FUNCTION_NAME_INDEX_SIZE too small for FUNCTION_INDEX_SIZE");
+static_assert(CALLBACK_NAME_INDEX_SIZE*3 >= CALLBACK_INDEX_SIZE*4,"CALLBACK_NAME_INDEX_SIZE too small for CALLBACK_INDEX_SIZE");
+#endif
+
+// must be a power of two and more than 4/3 of the largest indexed subset,
+// which is the pin name subset
+enum{SUBSET_INDEX_SIZE=128};
+
+// serialized api cache, one entry per verbosity and firmware selection, and
+// serialized result cache, one entry per cacheable function and arguments
+#if defined(__AVR__)
+enum{API_CACHE_SIZE=1};
+enum{API_CACHE_ENTRY_COUNT_MAX=1};
+enum{RESULT_CACHE_SIZE=1};
+enum{RESULT_CACHE_ENTRY_COUNT_MAX=1};
+#else
+enum{API_CACHE_SIZE=4096};
+enum{API_CACHE_ENTRY_COUNT_MAX=8};
+enum{RESULT_CACHE_SIZE=1024};
+enum{RESULT_CACHE_ENTRY_COUNT_MAX=8};
+#endif
+
+// api hashes computed in startServer, names and general verbosity for each
+// single firmware and for all firmware
+enum{API_HASH_FIRMWARE_SLOT_COUNT=FIRMWARE_COUNT_MAX+1};
+enum{API_HASH_COUNT_MAX=2*API_HASH_FIRMWARE_SLOT_COUNT};
 
 enum{JSON_DOCUMENT_SIZE=1024};
 
@@ -42,9 +125,12 @@ enum{STRING_LENGTH_SUBSET=257};
 enum{STRING_LENGTH_SUBSET_ELEMENT=32};
 enum{STRING_LENGTH_VERSION=18};
 enum{STRING_LENGTH_VERSION_PROPERTY=6};
+enum{STRING_LENGTH_API_HASH=9};
+enum{STRING_LENGTH_DOUBLE=32};
 enum{SUBSET_ELEMENT_COUNT_MAX=20};
 
 enum {JSON_TOKEN_MAX=32};
+enum {REQUEST_NESTING_MAX=8};
 
 enum {FIRMWARE_NAME_JSON_DOCUMENT_SIZE=128};
 
@@ -56,6 +142,20 @@ struct FirmwareInfo
   const size_t version_patch;
 };
 
+// name hashes of the elements of one firmware, generated from its api file
+// by tools/generate_element_tables.py, each table in flash and sorted
+struct ElementTables
+{
+  const uint32_t * const property_name_hashes;
+  const size_t property_count;
+  const uint32_t * const parameter_name_hashes;
+  const size_t parameter_count;
+  const uint32_t * const function_name_hashes;
+  const size_t function_count;
+  const uint32_t * const callback_name_hashes;
+  const size_t callback_count;
+};
+
 struct HardwareInfo
 {
   const ConstantString * const name_ptr;
@@ -83,6 +183,18 @@ extern const long response_pipe_read_max;
 
 extern const double epsilon;
 
+// Streams
+extern const size_t server_stream_byte_budget_default;
+extern const size_t server_stream_weight_default;
+extern const size_t server_stream_output_buffer_size_default;
+extern const size_t requests_per_call_max_default;
+
+// Methods
+extern const uint32_t method_id_hash_multiplier;
+
+// Firmware
+extern const FirmwareMask firmware_mask_all;
+
 // Pins
 enum{PIN_PWM_EVENT_COUNT_MAX=16};
 extern const size_t pin_pulse_timer_number;
@@ -124,6 +236,16 @@ extern ConstantString pin_value_parameter_name;
 extern const long pin_value_min;
 extern const long pin_value_max;
 
+extern ConstantString api_hash_parameter_name;
+
+extern ConstantString cursor_parameter_name;
+extern const long cursor_min;
+extern const long cursor_max;
+
+extern ConstantString page_size_parameter_name;
+extern const long page_size_min;
+extern const long page_size_max;
+
 // Functions
 extern ConstantString get_method_ids_function_name;
 extern ConstantString help_function_name;
@@ -131,14 +253,19 @@ extern ConstantString verbose_help_function_name;
 extern ConstantString get_device_id_function_name;
 extern ConstantString get_device_info_function_name;
 extern ConstantString get_api_function_name;
+extern ConstantString get_api_hash_function_name;
+extern ConstantString get_api_if_changed_function_name;
+extern ConstantString get_api_page_function_name;
 extern ConstantString get_property_default_values_function_name;
 extern ConstantString set_properties_to_defaults_function_name;
 extern ConstantString get_pin_info_function_name;
 extern ConstantString get_property_values_function_name;
+extern ConstantString get_property_values_page_function_name;
 extern ConstantString set_pin_mode_function_name;
 extern ConstantString get_pin_value_function_name;
 extern ConstantString set_pin_value_function_name;
 extern ConstantString get_memory_free_function_name;
+extern ConstantString get_function_ids_function_name;
 
 // Callbacks
 
@@ -152,6 +279,7 @@ extern ConstantString server_error_error_message;
 
 extern ConstantString object_request_error_data;
 extern ConstantString request_length_error_data;
+extern ConstantString function_handler_parameters_error_data;
 extern ConstantString parameter_not_found_error_data;
 extern ConstantString parameter_incorrect_type_error_data;
 extern ConstantString property_not_found_error_data;
@@ -205,6 +333,8 @@ extern ConstantString function_constant_string;
 extern ConstantString functions_constant_string;
 extern ConstantString callback_constant_string;
 extern ConstantString callbacks_constant_string;
+extern ConstantString property_functions_constant_string;
+extern ConstantString callback_functions_constant_string;
 extern ConstantString min_constant_string;
 extern ConstantString max_constant_string;
 extern ConstantString array_element_min_constant_string;
@@ -217,6 +347,9 @@ extern ConstantString part_number_constant_string;
 extern ConstantString device_id_constant_string;
 extern ConstantString device_info_constant_string;
 extern ConstantString api_constant_string;
+extern ConstantString unchanged_constant_string;
+extern ConstantString cursor_constant_string;
+extern ConstantString values_constant_string;
 extern ConstantString verbosity_constant_string;
 extern ConstantString value_constant_string;
 extern ConstantString default_value_constant_string;
@@ -0,0 +1,429 @@
+// ----------------------------------------------------------------------------
+// DoubleFormatter.cpp
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#include "DoubleFormatter.h"
+
+
+namespace modular_server
+{
+// normalized 10^k for k = -348, -340, ..., 340
+const DoubleFormatter::CachedPower DoubleFormatter::cached_powers_[] =
+{
+  {0xfa8fd5a0081c0288ULL,-1220},
+  {0xbaaee17fa23ebf76ULL,-1193},
+  {0x8b16fb203055ac76ULL,-1166},
+  {0xcf42894a5dce35eaULL,-1140},
+  {0x9a6bb0aa55653b2dULL,-1113},
+  {0xe61acf033d1a45dfULL,-1087},
+  {0xab70fe17c79ac6caULL,-1060},
+  {0xff77b1fcbebcdc4fULL,-1034},
+  {0xbe5691ef416bd60cULL,-1007},
+  {0x8dd01fad907ffc3cULL,-980},
+  {0xd3515c2831559a83ULL,-954},
+  {0x9d71ac8fada6c9b5ULL,-927},
+  {0xea9c227723ee8bcbULL,-901},
+  {0xaecc49914078536dULL,-874},
+  {0x823c12795db6ce57ULL,-847},
+  {0xc21094364dfb5637ULL,-821},
+  {0x9096ea6f3848984fULL,-794},
+  {0xd77485cb25823ac7ULL,-768},
+  {0xa086cfcd97bf97f4ULL,-741},
+  {0xef340a98172aace5ULL,-715},
+  {0xb23867fb2a35b28eULL,-688},
+  {0x84c8d4dfd2c63f3bULL,-661},
+  {0xc5dd44271ad3cdbaULL,-635},
+  {0x936b9fcebb25c996ULL,-608},
+  {0xdbac6c247d62a584ULL,-582},
+  {0xa3ab66580d5fdaf6ULL,-555},
+  {0xf3e2f893dec3f126ULL,-529},
+  {0xb5b5ada8aaff80b8ULL,-502},
+  {0x87625f056c7c4a8bULL,-475},
+  {0xc9bcff6034c13053ULL,-449},
+  {0x964e858c91ba2655ULL,-422},
+  {0xdff9772470297ebdULL,-396},
+  {0xa6dfbd9fb8e5b88fULL,-369},
+  {0xf8a95fcf88747d94ULL,-343},
+  {0xb94470938fa89bcfULL,-316},
+  {0x8a08f0f8bf0f156bULL,-289},
+  {0xcdb02555653131b6ULL,-263},
+  {0x993fe2c6d07b7facULL,-236},
+  {0xe45c10c42a2b3b06ULL,-210},
+  {0xaa242499697392d3ULL,-183},
+  {0xfd87b5f28300ca0eULL,-157},
+  {0xbce5086492111aebULL,-130},
+  {0x8cbccc096f5088ccULL,-103},
+  {0xd1b71758e219652cULL,-77},
+  {0x9c40000000000000ULL,-50},
+  {0xe8d4a51000000000ULL,-24},
+  {0xad78ebc5ac620000ULL,3},
+  {0x813f3978f8940984ULL,30},
+  {0xc097ce7bc90715b3ULL,56},
+  {0x8f7e32ce7bea5c70ULL,83},
+  {0xd5d238a4abe98068ULL,109},
+  {0x9f4f2726179a2245ULL,136},
+  {0xed63a231d4c4fb27ULL,162},
+  {0xb0de65388cc8ada8ULL,189},
+  {0x83c7088e1aab65dbULL,216},
+  {0xc45d1df942711d9aULL,242},
+  {0x924d692ca61be758ULL,269},
+  {0xda01ee641a708deaULL,295},
+  {0xa26da3999aef774aULL,322},
+  {0xf209787bb47d6b85ULL,348},
+  {0xb454e4a179dd1877ULL,375},
+  {0x865b86925b9bc5c2ULL,402},
+  {0xc83553c5c8965d3dULL,428},
+  {0x952ab45cfa97a0b3ULL,455},
+  {0xde469fbd99a05fe3ULL,481},
+  {0xa59bc234db398c25ULL,508},
+  {0xf6c69a72a3989f5cULL,534},
+  {0xb7dcbf5354e9beceULL,561},
+  {0x88fcf317f22241e2ULL,588},
+  {0xcc20ce9bd35c78a5ULL,614},
+  {0x98165af37b2153dfULL,641},
+  {0xe2a0b5dc971f303aULL,667},
+  {0xa8d9d1535ce3b396ULL,694},
+  {0xfb9b7cd9a4a7443cULL,720},
+  {0xbb764c4ca7a44410ULL,747},
+  {0x8bab8eefb6409c1aULL,774},
+  {0xd01fef10a657842cULL,800},
+  {0x9b10a4e5e9913129ULL,827},
+  {0xe7109bfba19c0c9dULL,853},
+  {0xac2820d9623bf429ULL,880},
+  {0x80444b5e7aa7cf85ULL,907},
+  {0xbf21e44003acdd2dULL,933},
+  {0x8e679c2f5e44ff8fULL,960},
+  {0xd433179d9c8cb841ULL,986},
+  {0x9e19db92b4e31ba9ULL,1013},
+  {0xeb96bf6ebadf77d9ULL,1039},
+  {0xaf87023b9bf0ee6bULL,1066}
+};
+
+const uint64_t DoubleFormatter::powers_of_ten_[] =
+{
+  1ULL,
+  10ULL,
+  100ULL,
+  1000ULL,
+  10000ULL,
+  100000ULL,
+  1000000ULL,
+  10000000ULL,
+  100000000ULL,
+  1000000000ULL,
+  10000000000ULL,
+  100000000000ULL,
+  1000000000000ULL,
+  10000000000000ULL,
+  100000000000000ULL,
+  1000000000000000ULL,
+  10000000000000000ULL,
+  100000000000000000ULL,
+  1000000000000000000ULL,
+  10000000000000000000ULL
+};
+
+// public
+size_t DoubleFormatter::toString(double value,
+  char * destination)
+{
+#if (__SIZEOF_DOUBLE__ == 8)
+  char * start = destination;
+  if (value < 0)
+  {
+    *destination++ = '-';
+    value = -value;
+  }
+  else if ((value == 0) && signbit(value))
+  {
+    *destination++ = '-';
+  }
+  if (value == 0)
+  {
+    strcpy(destination,"0.0");
+    return (destination - start) + 3;
+  }
+  int length;
+  int k;
+  grisu2(value,destination,length,k);
+  size_t size = prettify(destination,length,k);
+  destination[size] = '\0';
+  return (destination - start) + size;
+#else
+  dtostrf(value,0,JsonStream::DOUBLE_DIGITS_DEFAULT,destination);
+  return strlen(destination);
+#endif
+}
+
+// private
+DoubleFormatter::DiyFp DoubleFormatter::multiply(DiyFp x,
+  DiyFp y)
+{
+  // upper 64 bits of the 128 bit product, rounded
+  const uint64_t mask_32 = 0xFFFFFFFFULL;
+  uint64_t a = x.f >> 32;
+  uint64_t b = x.f & mask_32;
+  uint64_t c = y.f >> 32;
+  uint64_t d = y.f & mask_32;
+  uint64_t ac = a*c;
+  uint64_t bc = b*c;
+  uint64_t ad = a*d;
+  uint64_t bd = b*d;
+  uint64_t tmp = (bd >> 32) + (ad & mask_32) + (bc & mask_32);
+  tmp += 1ULL << 31;
+  DiyFp product;
+  product.f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+  product.e = x.e + y.e + 64;
+  return product;
+}
+
+DoubleFormatter::DiyFp DoubleFormatter::normalize(DiyFp x)
+{
+  while (!(x.f & (1ULL << 63)))
+  {
+    x.f <<= 1;
+    --x.e;
+  }
+  return x;
+}
+
+DoubleFormatter::DiyFp DoubleFormatter::getCachedPower(int e,
+  int & k)
+{
+  // smallest cached power that brings the binary exponent to at least -60
+  double dk = (-61 - e)*0.30102999566398114 + 347;
+  int ik = (int)dk;
+  if ((dk - ik) > 0.0)
+  {
+    ++ik;
+  }
+  unsigned index = (unsigned)((ik >> 3) + 1);
+  k = -(-348 + (int)(index << 3));
+  DiyFp cached_power;
+  cached_power.f = cached_powers_[index].f;
+  cached_power.e = cached_powers_[index].e;
+  return cached_power;
+}
+
+void DoubleFormatter::grisu2(double value,
+  char * digits,
+  int & length,
+  int & k)
+{
+  const uint64_t hidden_bit = 1ULL << 52;
+  const uint64_t significand_mask = hidden_bit - 1;
+  uint64_t bits;
+  memcpy(&bits,&value,sizeof(bits));
+  int biased_e = (int)((bits >> 52) & 0x7FF);
+  uint64_t significand = bits & significand_mask;
+
+  DiyFp v;
+  if (biased_e != 0)
+  {
+    v.f = significand + hidden_bit;
+    v.e = biased_e - 1075;
+  }
+  else
+  {
+    v.f = significand;
+    v.e = -1074;
+  }
+
+  // boundaries halfway to the neighboring doubles
+  DiyFp plus;
+  plus.f = (v.f << 1) + 1;
+  plus.e = v.e - 1;
+  while (!(plus.f & (hidden_bit << 1)))
+  {
+    plus.f <<= 1;
+    --plus.e;
+  }
+  plus.f <<= 10;
+  plus.e -= 10;
+  DiyFp minus;
+  if (v.f == hidden_bit)
+  {
+    minus.f = (v.f << 2) - 1;
+    minus.e = v.e - 2;
+  }
+  else
+  {
+    minus.f = (v.f << 1) - 1;
+    minus.e = v.e - 1;
+  }
+  minus.f <<= minus.e - plus.e;
+  minus.e = plus.e;
+
+  DiyFp c_mk = getCachedPower(plus.e,k);
+  DiyFp w = multiply(normalize(v),c_mk);
+  DiyFp wp = multiply(plus,c_mk);
+  DiyFp wm = multiply(minus,c_mk);
+  ++wm.f;
+  --wp.f;
+  generateDigits(w,wp,wp.f - wm.f,digits,length,k);
+}
+
+void DoubleFormatter::generateDigits(DiyFp w,
+  DiyFp mp,
+  uint64_t delta,
+  char * digits,
+  int & length,
+  int & k)
+{
+  const int one_e = mp.e;
+  const uint64_t one_f = 1ULL << -one_e;
+  const uint64_t wp_w = mp.f - w.f;
+  uint32_t p1 = (uint32_t)(mp.f >> -one_e);
+  uint64_t p2 = mp.f & (one_f - 1);
+  int kappa = countDecimalDigits(p1);
+  length = 0;
+
+  while (kappa > 0)
+  {
+    uint32_t power = (uint32_t)powers_of_ten_[kappa - 1];
+    uint32_t d = p1/power;
+    p1 %= power;
+    if (d || length)
+    {
+      digits[length++] = '0' + (char)d;
+    }
+    --kappa;
+    uint64_t rest = ((uint64_t)p1 << -one_e) + p2;
+    if (rest <= delta)
+    {
+      k += kappa;
+      roundDigit(digits,length,delta,rest,(uint64_t)powers_of_ten_[kappa] << -one_e,wp_w);
+      return;
+    }
+  }
+
+  while (true)
+  {
+    p2 *= 10;
+    delta *= 10;
+    char d = (char)(p2 >> -one_e);
+    if (d || length)
+    {
+      digits[length++] = '0' + d;
+    }
+    p2 &= one_f - 1;
+    --kappa;
+    if (p2 < delta)
+    {
+      k += kappa;
+      int index = -kappa;
+      roundDigit(digits,length,delta,p2,one_f,wp_w*powers_of_ten_[index]);
+      return;
+    }
+  }
+}
+
+void DoubleFormatter::roundDigit(char * digits,
+  int length,
+  uint64_t delta,
+  uint64_t rest,
+  uint64_t ten_kappa,
+  uint64_t wp_w)
+{
+  while ((rest < wp_w) &&
+    ((delta - rest) >= ten_kappa) &&
+    (((rest + ten_kappa) < wp_w) ||
+      ((wp_w - rest) > (rest + ten_kappa - wp_w))))
+  {
+    --digits[length - 1];
+    rest += ten_kappa;
+  }
+}
+
+int DoubleFormatter::countDecimalDigits(uint32_t n)
+{
+  int count = 1;
+  while ((count < 10) && (n >= powers_of_ten_[count]))
+  {
+    ++count;
+  }
+  return count;
+}
+
+size_t DoubleFormatter::prettify(char * digits,
+  int length,
+  int k)
+{
+  // digits holds the decimal significand, the value is digits*10^k
+  const int kk = length + k;
+  if ((k >= 0) && (kk <= 21))
+  {
+    // 1234e7 -> 12340000000.0
+    for (int i=length; i<kk; ++i)
+    {
+      digits[i] = '0';
+    }
+    digits[kk] = '.';
+    digits[kk + 1] = '0';
+    return kk + 2;
+  }
+  if ((kk > 0) && (kk <= 21))
+  {
+    // 1234e-2 -> 12.34
+    memmove(&digits[kk + 1],&digits[kk],length - kk);
+    digits[kk] = '.';
+    return length + 1;
+  }
+  if ((kk > -6) && (kk <= 0))
+  {
+    // 1234e-6 -> 0.001234
+    int offset = 2 - kk;
+    memmove(&digits[offset],&digits[0],length);
+    digits[0] = '0';
+    digits[1] = '.';
+    for (int i=2; i<offset; ++i)
+    {
+      digits[i] = '0';
+    }
+    return length + offset;
+  }
+  if (length == 1)
+  {
+    // 1e30
+    digits[1] = 'e';
+    return 2 + writeExponent(kk - 1,&digits[2]);
+  }
+  // 1234e30 -> 1.234e33
+  memmove(&digits[2],&digits[1],length - 1);
+  digits[1] = '.';
+  digits[length + 1] = 'e';
+  return length + 2 + writeExponent(kk - 1,&digits[length + 2]);
+}
+
+size_t DoubleFormatter::writeExponent(int k,
+  char * destination)
+{
+  char * start = destination;
+  if (k < 0)
+  {
+    *destination++ = '-';
+    k = -k;
+  }
+  if (k >= 100)
+  {
+    *destination++ = '0' + (char)(k/100);
+    k %= 100;
+    *destination++ = '0' + (char)(k/10);
+    *destination++ = '0' + (char)(k%10);
+  }
+  else if (k >= 10)
+  {
+    *destination++ = '0' + (char)(k/10);
+    *destination++ = '0' + (char)(k%10);
+  }
+  else
+  {
+    *destination++ = '0' + (char)k;
+  }
+  return destination - start;
+}
+
+}
@@ -0,0 +1,73 @@
+// ----------------------------------------------------------------------------
+// DoubleFormatter.h
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_DOUBLE_FORMATTER_H_
+#define _MODULAR_SERVER_DOUBLE_FORMATTER_H_
+#include <Arduino.h>
+#include <JsonStream.h>
+
+#include "Constants.h"
+
+
+namespace modular_server
+{
+// Formats finite doubles as the shortest json number that reads back as the
+// same double, using the Grisu2 algorithm on 64 bit integers only. Boards
+// where double is only 32 bits fall back to dtostrf.
+class DoubleFormatter
+{
+public:
+  // destination must hold constants::STRING_LENGTH_DOUBLE characters,
+  // returns the string length
+  static size_t toString(double value,
+    char * destination);
+
+private:
+  struct DiyFp
+  {
+    uint64_t f;
+    int e;
+  };
+  struct CachedPower
+  {
+    uint64_t f;
+    int16_t e;
+  };
+  static const CachedPower cached_powers_[];
+  static const uint64_t powers_of_ten_[];
+
+  static DiyFp multiply(DiyFp x,
+    DiyFp y);
+  static DiyFp normalize(DiyFp x);
+  static DiyFp getCachedPower(int e,
+    int & k);
+  static void grisu2(double value,
+    char * digits,
+    int & length,
+    int & k);
+  static void generateDigits(DiyFp w,
+    DiyFp mp,
+    uint64_t delta,
+    char * digits,
+    int & length,
+    int & k);
+  static void roundDigit(char * digits,
+    int length,
+    uint64_t delta,
+    uint64_t rest,
+    uint64_t ten_kappa,
+    uint64_t wp_w);
+  static int countDecimalDigits(uint32_t n);
+  static size_t prettify(char * digits,
+    int length,
+    int k);
+  static size_t writeExponent(int k,
+    char * destination);
+};
+}
+
+#endif
@@ -0,0 +1,56 @@
+// ----------------------------------------------------------------------------
+// ElementTableIndex.h
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_ELEMENT_TABLE_INDEX_H_
+#define _MODULAR_SERVER_ELEMENT_TABLE_INDEX_H_
+#include <Arduino.h>
+#include <Array.h>
+
+#include "Constants.h"
+
+
+namespace modular_server
+{
+// Index over the flash name hash tables generated from the firmware api
+// files. Tables are sorted, so a name is found by binary search, and each
+// table entry costs one byte of ram holding the index of the element that
+// was created with that name. Like HashIndex, find only returns candidates
+// that the caller must confirm against the real name.
+template <size_t SIZE>
+class ElementTableIndex
+{
+public:
+  ElementTableIndex();
+
+  void clear();
+  bool addTable(const uint32_t * name_hashes,
+    size_t count);
+  bool insert(uint32_t hash,
+    size_t value);
+  int find(uint32_t hash,
+    size_t & probe);
+
+private:
+  struct Table
+  {
+    const uint32_t * name_hashes;
+    size_t count;
+    size_t offset;
+  };
+  Array<Table,constants::FIRMWARE_COUNT_MAX> tables_;
+  uint8_t values_[SIZE];
+  size_t size_;
+
+  static uint32_t getNameHash(const Table & table,
+    size_t position);
+  static size_t lowerBound(const Table & table,
+    uint32_t hash);
+};
+}
+#include "ElementTableIndexDefinitions.h"
+
+#endif
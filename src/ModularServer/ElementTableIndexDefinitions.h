@@ -0,0 +1,152 @@
+// ----------------------------------------------------------------------------
+// ElementTableIndexDefinitions.h
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_ELEMENT_TABLE_INDEX_DEFINITIONS_H_
+#define _MODULAR_SERVER_ELEMENT_TABLE_INDEX_DEFINITIONS_H_
+
+
+namespace modular_server
+{
+// public
+template <size_t SIZE>
+ElementTableIndex<SIZE>::ElementTableIndex()
+{
+  static_assert(SIZE < UINT8_MAX,"ElementTableIndex SIZE must fit element indexes in a byte");
+  clear();
+}
+
+template <size_t SIZE>
+void ElementTableIndex<SIZE>::clear()
+{
+  tables_.clear();
+  for (size_t i=0; i<SIZE; ++i)
+  {
+    values_[i] = UINT8_MAX;
+  }
+  size_ = 0;
+}
+
+template <size_t SIZE>
+bool ElementTableIndex<SIZE>::addTable(const uint32_t * name_hashes,
+  size_t count)
+{
+  if ((name_hashes == NULL) || (count == 0))
+  {
+    return true;
+  }
+  if (tables_.full() || ((size_ + count) > SIZE))
+  {
+    return false;
+  }
+  Table table;
+  table.name_hashes = name_hashes;
+  table.count = count;
+  table.offset = size_;
+  // a table out of order would hide names from the binary search, so it is
+  // left out and its elements go to the ram hash index instead
+  for (size_t position=1; position<count; ++position)
+  {
+    if (getNameHash(table,position) < getNameHash(table,position - 1))
+    {
+      return false;
+    }
+  }
+  tables_.push_back(table);
+  size_ += count;
+  return true;
+}
+
+template <size_t SIZE>
+bool ElementTableIndex<SIZE>::insert(uint32_t hash,
+  size_t value)
+{
+  if (value >= UINT8_MAX)
+  {
+    return false;
+  }
+  for (size_t table_index=0; table_index<tables_.size(); ++table_index)
+  {
+    const Table & table = tables_[table_index];
+    for (size_t position=lowerBound(table,hash);
+         (position < table.count) && (getNameHash(table,position) == hash);
+         ++position)
+    {
+      uint8_t & table_value = values_[table.offset + position];
+      if (table_value == UINT8_MAX)
+      {
+        table_value = value;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+template <size_t SIZE>
+int ElementTableIndex<SIZE>::find(uint32_t hash,
+  size_t & probe)
+{
+  // probe is the flat position of the next table entry to try, so repeated
+  // calls walk every entry with a matching hash across all of the tables
+  for (size_t table_index=0; table_index<tables_.size(); ++table_index)
+  {
+    const Table & table = tables_[table_index];
+    if (probe >= (table.offset + table.count))
+    {
+      continue;
+    }
+    size_t position = lowerBound(table,hash);
+    if ((table.offset + position) < probe)
+    {
+      position = probe - table.offset;
+    }
+    while ((position < table.count) && (getNameHash(table,position) == hash))
+    {
+      probe = table.offset + position + 1;
+      uint8_t value = values_[table.offset + position];
+      if (value != UINT8_MAX)
+      {
+        return value;
+      }
+      ++position;
+    }
+    probe = table.offset + table.count;
+  }
+  return -1;
+}
+
+// private
+template <size_t SIZE>
+uint32_t ElementTableIndex<SIZE>::getNameHash(const Table & table,
+  size_t position)
+{
+  return pgm_read_dword(table.name_hashes + position);
+}
+
+template <size_t SIZE>
+size_t ElementTableIndex<SIZE>::lowerBound(const Table & table,
+  uint32_t hash)
+{
+  size_t begin = 0;
+  size_t end = table.count;
+  while (begin < end)
+  {
+    size_t middle = begin + (end - begin)/2;
+    if (getNameHash(table,middle) < hash)
+    {
+      begin = middle + 1;
+    }
+    else
+    {
+      end = middle;
+    }
+  }
+  return begin;
+}
+
+}
+#endif
@@ -0,0 +1,68 @@
+// ----------------------------------------------------------------------------
+// ElementTables.h
+//
+// Generated from api/ModularServer.json
+// by tools/generate_element_tables.py, do not edit.
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_ELEMENT_TABLES_H_
+#define _MODULAR_SERVER_ELEMENT_TABLES_H_
+#include "Constants.h"
+
+
+namespace modular_server
+{
+namespace constants
+{
+const uint32_t property_name_hashes[] PROGMEM =
+{
+  0xE2FA0E24UL // serialNumber
+};
+
+const uint32_t parameter_name_hashes[] PROGMEM =
+{
+  0x7AA6946CUL, // firmware
+  0x7D8F94EAUL, // page_size
+  0xA99C4BCAUL, // verbosity
+  0xC235ED2EUL, // pin_mode
+  0xD1FDE798UL, // api_hash
+  0xD7F8291EUL, // pin_value
+  0xE336320FUL, // cursor
+  0xF58F574AUL // pin_name
+};
+
+const uint32_t function_name_hashes[] PROGMEM =
+{
+  0x1138C3CDUL, // getApi
+  0x14D0F7FFUL, // getPinValue
+  0x3C1E6C79UL, // getApiHash
+  0x4BC9FCA8UL, // getDeviceId
+  0x53686C4DUL, // getDeviceInfo
+  0x5FA843B7UL, // getPropertyValuesPage
+  0x87FD29A1UL, // setPropertiesToDefaults
+  0x8A9E0291UL, // setPinMode
+  0x8BED0BFCUL, // getPropertyValues
+  0x9A6FC5EAUL, // getApiIfChanged
+  0xCE2D144BUL, // getFunctionIds
+  0xD0E06901UL, // getPropertyDefaultValues
+  0xD0EE977EUL, // getPinInfo
+  0xF5858FF3UL, // setPinValue
+  0xF6FE8C7EUL // getApiPage
+};
+
+const ElementTables element_tables =
+{
+  property_name_hashes,
+  1,
+  parameter_name_hashes,
+  8,
+  function_name_hashes,
+  15,
+  NULL,
+  0
+};
+}
+}
+#endif
@@ -14,6 +14,7 @@ namespace modular_server
 FirmwareElement::FirmwareElement()
 {
   setFirmwareName(constants::empty_constant_string);
+  firmware_bit_ = 0;
 }
 
 void FirmwareElement::setFirmwareName(const ConstantString & firmware_name)
@@ -21,6 +22,17 @@ void FirmwareElement::setFirmwareName(const ConstantString & firmware_name)
   firmware_name_ptr_ = &firmware_name;
 }
 
+void FirmwareElement::setFirmwareIndex(size_t firmware_index)
+{
+  firmware_bit_ = 1 << firmware_index;
+}
+
+bool FirmwareElement::firmwareInMask(constants::FirmwareMask firmware_mask)
+{
+  // ALL also matches elements never assigned to a firmware
+  return ((firmware_mask == constants::firmware_mask_all) || (firmware_bit_ & firmware_mask));
+}
+
 bool FirmwareElement::compareFirmwareName(const char * firmware_name_to_compare)
 {
   if (constants::all_constant_string == firmware_name_to_compare)
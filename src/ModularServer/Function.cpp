@@ -19,6 +19,10 @@ Function::Function()
 void Function::attachFunctor(const Functor0 & functor)
 {
   functor_ = functor;
+  typed_functor_.clear();
+  typed_functor_check_ = NULL;
+  typed_functor_call_ = NULL;
+  typed_functor_parameters_ok_ = false;
 }
 
 void Function::addParameter(Parameter & parameter)
@@ -28,6 +32,7 @@ void Function::addParameter(Parameter & parameter)
   if (parameter_index < 0)
   {
     parameter_ptrs_.push_back(&parameter);
+    checkTypedFunctor();
   }
 }
 
@@ -151,6 +156,11 @@ const ConstantString & Function::getResultUnits()
   return *result_units_ptr_;
 }
 
+void Function::setResultCacheable()
+{
+  result_cacheable_ = true;
+}
+
 // protected
 
 // private
@@ -165,6 +175,11 @@ void Function::setup(const ConstantString & name)
   result_type_ = JsonStream::NULL_TYPE;
   result_array_element_type_ = JsonStream::NULL_TYPE;
   setResultUnits(constants::empty_constant_string);
+  result_cacheable_ = false;
+  typed_functor_.clear();
+  typed_functor_check_ = NULL;
+  typed_functor_call_ = NULL;
+  typed_functor_parameters_ok_ = false;
 }
 
 int Function::findParameterIndex(const ConstantString & parameter_name)
@@ -186,12 +201,108 @@ size_t Function::getParameterCount()
   return parameter_ptrs_.size();
 }
 
-void Function::functor()
+bool Function::resultCacheable()
 {
-  if (functor_)
+  return result_cacheable_;
+}
+
+bool Function::functor()
+{
+  if (typed_functor_call_)
+  {
+    if (!typed_functor_parameters_ok_)
+    {
+      return false;
+    }
+    typed_functor_call_(*this);
+  }
+  else if (functor_)
   {
     functor_();
   }
+  return true;
+}
+
+void Function::checkTypedFunctor()
+{
+  // parameters are usually added after the handler is attached, so the
+  // handler signature is checked again each time either one changes
+  if (typed_functor_check_)
+  {
+    typed_functor_parameters_ok_ = typed_functor_check_(*this);
+  }
+}
+
+bool Function::argumentTypeMatches(Parameter & parameter,
+  long * argument)
+{
+  return (parameter.getType() == JsonStream::LONG_TYPE);
+}
+
+bool Function::argumentTypeMatches(Parameter & parameter,
+  double * argument)
+{
+  return (parameter.getType() == JsonStream::DOUBLE_TYPE);
+}
+
+bool Function::argumentTypeMatches(Parameter & parameter,
+  bool * argument)
+{
+  return (parameter.getType() == JsonStream::BOOL_TYPE);
+}
+
+bool Function::argumentTypeMatches(Parameter & parameter,
+  const char * * argument)
+{
+  return (parameter.getType() == JsonStream::STRING_TYPE);
+}
+
+bool Function::argumentTypeMatches(Parameter & parameter,
+  ArduinoJson::JsonArray * argument)
+{
+  return (parameter.getType() == JsonStream::ARRAY_TYPE);
+}
+
+bool Function::argumentTypeMatches(Parameter & parameter,
+  ArduinoJson::JsonObject * argument)
+{
+  return (parameter.getType() == JsonStream::OBJECT_TYPE);
+}
+
+void Function::decodeArgument(Parameter & parameter,
+  long & argument)
+{
+  argument = parameter.getRequestLong();
+}
+
+void Function::decodeArgument(Parameter & parameter,
+  double & argument)
+{
+  argument = parameter.getRequestDouble();
+}
+
+void Function::decodeArgument(Parameter & parameter,
+  bool & argument)
+{
+  argument = parameter.getRequestBool();
+}
+
+void Function::decodeArgument(Parameter & parameter,
+  const char * & argument)
+{
+  argument = parameter.getRequestString();
+}
+
+void Function::decodeArgument(Parameter & parameter,
+  ArduinoJson::JsonArray & argument)
+{
+  argument = parameter.getRequestValue().as<ArduinoJson::JsonArray>();
+}
+
+void Function::decodeArgument(Parameter & parameter,
+  ArduinoJson::JsonObject & argument)
+{
+  argument = parameter.getRequestValue().as<ArduinoJson::JsonObject>();
 }
 
 void Function::writeApi(Response & response,
@@ -267,4 +378,39 @@ void Function::writeApi(Response & response,
   response.endObject();
 }
 
+Function::TypedFunctor::TypedFunctor()
+{
+  clear();
+}
+
+Function::TypedFunctor::TypedFunctor(const TypedFunctor & typed_functor)
+{
+  assign(typed_functor);
+}
+
+Function::TypedFunctor & Function::TypedFunctor::operator=(const TypedFunctor & typed_functor)
+{
+  if (this != &typed_functor)
+  {
+    assign(typed_functor);
+  }
+  return *this;
+}
+
+void Function::TypedFunctor::clear()
+{
+  functor_ptr_ = NULL;
+  copy_ = NULL;
+}
+
+void Function::TypedFunctor::assign(const TypedFunctor & typed_functor)
+{
+  clear();
+  if (typed_functor.functor_ptr_)
+  {
+    copy_ = typed_functor.copy_;
+    copy_(*this,typed_functor);
+  }
+}
+
 }
@@ -7,6 +7,7 @@
 // ----------------------------------------------------------------------------
 #ifndef _MODULAR_SERVER_FUNCTION_H_
 #define _MODULAR_SERVER_FUNCTION_H_
+#include <new>
 #include <Streaming.h>
 #include <Array.h>
 #include <ConstantVariable.h>
@@ -27,6 +28,15 @@ public:
   Function();
 
   void attachFunctor(const Functor0 & functor);
+  template <typename P1>
+  void attachFunctor(const Functor1<P1> & functor);
+  template <typename P1,
+    typename P2>
+  void attachFunctor(const Functor2<P1,P2> & functor);
+  template <typename P1,
+    typename P2,
+    typename P3>
+  void attachFunctor(const Functor3<P1,P2,P3> & functor);
   void addParameter(Parameter & parameter);
 
   void setResultTypeLong();
@@ -44,18 +54,104 @@ public:
   void setResultUnits(const ConstantString & units);
   const ConstantString & getResultUnits();
 
+  // the handler of a result cacheable function must only read state, write
+  // its result after writeResultKey and never return an error, the server
+  // then replays its serialized result until the cache is invalidated
+  void setResultCacheable();
+
 private:
+  typedef bool (*TypedFunctorCheck)(Function & function);
+  typedef void (*TypedFunctorCall)(Function & function);
+  // typed handlers are constructed in place, every FunctorN has the same
+  // layout, and copying a function copy constructs its handler
+  class TypedFunctor
+  {
+  public:
+    TypedFunctor();
+    TypedFunctor(const TypedFunctor & typed_functor);
+    TypedFunctor & operator=(const TypedFunctor & typed_functor);
+    template <typename T>
+    void set(const T & functor);
+    template <typename T>
+    const T & get() const;
+    void clear();
+  private:
+    typedef void (*Copy)(TypedFunctor & destination,
+      const TypedFunctor & source);
+    alignas(Functor3<long,long,long>) unsigned char storage_[sizeof(Functor3<long,long,long>)];
+    void * functor_ptr_;
+    Copy copy_;
+    void assign(const TypedFunctor & typed_functor);
+    template <typename T>
+    static void copy(TypedFunctor & destination,
+      const TypedFunctor & source);
+  };
   Functor0 functor_;
+  TypedFunctor typed_functor_;
+  TypedFunctorCheck typed_functor_check_;
+  TypedFunctorCall typed_functor_call_;
+  bool typed_functor_parameters_ok_;
   Array<Parameter *,constants::FUNCTION_PARAMETER_COUNT_MAX> parameter_ptrs_;
   JsonStream::JsonTypes result_type_;
   JsonStream::JsonTypes result_array_element_type_;
   const ConstantString * result_units_ptr_;
+  bool result_cacheable_;
 
   Function(const ConstantString & name);
   void setup(const ConstantString & name);
   int findParameterIndex(const ConstantString & parameter_name);
   size_t getParameterCount();
-  void functor();
+  bool resultCacheable();
+  bool functor();
+  template <typename T>
+  void setTypedFunctor(const T & functor,
+    TypedFunctorCheck check,
+    TypedFunctorCall call);
+  template <typename T>
+  const T & getTypedFunctor();
+  void checkTypedFunctor();
+  template <typename P1>
+  static bool typedFunctorParametersOk(Function & function);
+  template <typename P1,
+    typename P2>
+  static bool typedFunctorParametersOk(Function & function);
+  template <typename P1,
+    typename P2,
+    typename P3>
+  static bool typedFunctorParametersOk(Function & function);
+  template <typename P1>
+  static void callTypedFunctor(Function & function);
+  template <typename P1,
+    typename P2>
+  static void callTypedFunctor(Function & function);
+  template <typename P1,
+    typename P2,
+    typename P3>
+  static void callTypedFunctor(Function & function);
+  static bool argumentTypeMatches(Parameter & parameter,
+    long * argument);
+  static bool argumentTypeMatches(Parameter & parameter,
+    double * argument);
+  static bool argumentTypeMatches(Parameter & parameter,
+    bool * argument);
+  static bool argumentTypeMatches(Parameter & parameter,
+    const char * * argument);
+  static bool argumentTypeMatches(Parameter & parameter,
+    ArduinoJson::JsonArray * argument);
+  static bool argumentTypeMatches(Parameter & parameter,
+    ArduinoJson::JsonObject * argument);
+  static void decodeArgument(Parameter & parameter,
+    long & argument);
+  static void decodeArgument(Parameter & parameter,
+    double & argument);
+  static void decodeArgument(Parameter & parameter,
+    bool & argument);
+  static void decodeArgument(Parameter & parameter,
+    const char * & argument);
+  static void decodeArgument(Parameter & parameter,
+    ArduinoJson::JsonArray & argument);
+  static void decodeArgument(Parameter & parameter,
+    ArduinoJson::JsonObject & argument);
   void writeApi(Response & response,
     bool write_name_only,
     bool write_method_type,
@@ -67,4 +163,6 @@ private:
   friend class Server;
 };
 }
+#include "FunctionDefinitions.h"
+
 #endif
@@ -0,0 +1,144 @@
+// ----------------------------------------------------------------------------
+// FunctionDefinitions.h
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_FUNCTION_DEFINITIONS_H_
+#define _MODULAR_SERVER_FUNCTION_DEFINITIONS_H_
+
+
+namespace modular_server
+{
+// public
+template <typename P1>
+void Function::attachFunctor(const Functor1<P1> & functor)
+{
+  setTypedFunctor(functor,
+    &Function::typedFunctorParametersOk<P1>,
+    &Function::callTypedFunctor<P1>);
+}
+
+template <typename P1,
+  typename P2>
+void Function::attachFunctor(const Functor2<P1,P2> & functor)
+{
+  setTypedFunctor(functor,
+    &Function::typedFunctorParametersOk<P1,P2>,
+    &Function::callTypedFunctor<P1,P2>);
+}
+
+template <typename P1,
+  typename P2,
+  typename P3>
+void Function::attachFunctor(const Functor3<P1,P2,P3> & functor)
+{
+  setTypedFunctor(functor,
+    &Function::typedFunctorParametersOk<P1,P2,P3>,
+    &Function::callTypedFunctor<P1,P2,P3>);
+}
+
+// private
+template <typename T>
+void Function::setTypedFunctor(const T & functor,
+  TypedFunctorCheck check,
+  TypedFunctorCall call)
+{
+  typed_functor_.set(functor);
+  functor_ = Functor0();
+  typed_functor_check_ = check;
+  typed_functor_call_ = call;
+  checkTypedFunctor();
+}
+
+template <typename T>
+const T & Function::getTypedFunctor()
+{
+  return typed_functor_.get<T>();
+}
+
+template <typename P1>
+bool Function::typedFunctorParametersOk(Function & function)
+{
+  return ((function.parameter_ptrs_.size() == 1) &&
+    argumentTypeMatches(*function.parameter_ptrs_[0],(P1 *)0));
+}
+
+template <typename P1,
+  typename P2>
+bool Function::typedFunctorParametersOk(Function & function)
+{
+  return ((function.parameter_ptrs_.size() == 2) &&
+    argumentTypeMatches(*function.parameter_ptrs_[0],(P1 *)0) &&
+    argumentTypeMatches(*function.parameter_ptrs_[1],(P2 *)0));
+}
+
+template <typename P1,
+  typename P2,
+  typename P3>
+bool Function::typedFunctorParametersOk(Function & function)
+{
+  return ((function.parameter_ptrs_.size() == 3) &&
+    argumentTypeMatches(*function.parameter_ptrs_[0],(P1 *)0) &&
+    argumentTypeMatches(*function.parameter_ptrs_[1],(P2 *)0) &&
+    argumentTypeMatches(*function.parameter_ptrs_[2],(P3 *)0));
+}
+
+template <typename P1>
+void Function::callTypedFunctor(Function & function)
+{
+  P1 p1;
+  decodeArgument(*function.parameter_ptrs_[0],p1);
+  function.getTypedFunctor<Functor1<P1> >()(p1);
+}
+
+template <typename P1,
+  typename P2>
+void Function::callTypedFunctor(Function & function)
+{
+  P1 p1;
+  decodeArgument(*function.parameter_ptrs_[0],p1);
+  P2 p2;
+  decodeArgument(*function.parameter_ptrs_[1],p2);
+  function.getTypedFunctor<Functor2<P1,P2> >()(p1,p2);
+}
+
+template <typename P1,
+  typename P2,
+  typename P3>
+void Function::callTypedFunctor(Function & function)
+{
+  P1 p1;
+  decodeArgument(*function.parameter_ptrs_[0],p1);
+  P2 p2;
+  decodeArgument(*function.parameter_ptrs_[1],p2);
+  P3 p3;
+  decodeArgument(*function.parameter_ptrs_[2],p3);
+  function.getTypedFunctor<Functor3<P1,P2,P3> >()(p1,p2,p3);
+}
+
+template <typename T>
+void Function::TypedFunctor::set(const T & functor)
+{
+  static_assert(sizeof(T) <= sizeof(storage_),"Typed functor does not fit in Function storage");
+  static_assert(alignof(T) <= alignof(Functor3<long,long,long>),"Typed functor alignment exceeds Function storage");
+  functor_ptr_ = new (storage_) T(functor);
+  copy_ = &TypedFunctor::copy<T>;
+}
+
+template <typename T>
+const T & Function::TypedFunctor::get() const
+{
+  return *static_cast<const T *>(functor_ptr_);
+}
+
+template <typename T>
+void Function::TypedFunctor::copy(TypedFunctor & destination,
+  const TypedFunctor & source)
+{
+  destination.functor_ptr_ = new (destination.storage_) T(source.get<T>());
+}
+
+}
+#endif
@@ -0,0 +1,45 @@
+// ----------------------------------------------------------------------------
+// HashIndex.h
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_HASH_INDEX_H_
+#define _MODULAR_SERVER_HASH_INDEX_H_
+#include <Arduino.h>
+
+
+namespace modular_server
+{
+// Open addressing table mapping 32 bit hashes to small non-negative
+// indices. Hashes may collide, so find only returns candidates that the
+// caller must confirm against the real key.
+template <size_t SIZE>
+class HashIndex
+{
+public:
+  HashIndex();
+
+  void clear();
+  bool insert(uint32_t hash,
+    size_t value);
+  int find(uint32_t hash,
+    size_t & probe);
+  size_t size();
+
+private:
+  struct Entry
+  {
+    uint16_t tag;
+    int16_t value;
+  };
+  Entry entries_[SIZE];
+  size_t size_;
+
+  uint16_t tag(uint32_t hash);
+};
+}
+#include "HashIndexDefinitions.h"
+
+#endif
@@ -0,0 +1,88 @@
+// ----------------------------------------------------------------------------
+// HashIndexDefinitions.h
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_HASH_INDEX_DEFINITIONS_H_
+#define _MODULAR_SERVER_HASH_INDEX_DEFINITIONS_H_
+
+
+namespace modular_server
+{
+// public
+template <size_t SIZE>
+HashIndex<SIZE>::HashIndex()
+{
+  static_assert((SIZE > 0) && ((SIZE & (SIZE - 1)) == 0),"HashIndex SIZE must be a power of two");
+  clear();
+}
+
+template <size_t SIZE>
+void HashIndex<SIZE>::clear()
+{
+  for (size_t i=0; i<SIZE; ++i)
+  {
+    entries_[i].tag = 0;
+    entries_[i].value = -1;
+  }
+  size_ = 0;
+}
+
+template <size_t SIZE>
+bool HashIndex<SIZE>::insert(uint32_t hash,
+  size_t value)
+{
+  // keep the load factor at or below 3/4 so probe sequences stay short
+  if (((size_ + 1) * 4 > SIZE * 3) || (value > INT16_MAX))
+  {
+    return false;
+  }
+  size_t slot = hash & (SIZE - 1);
+  while (entries_[slot].value >= 0)
+  {
+    slot = (slot + 1) & (SIZE - 1);
+  }
+  entries_[slot].tag = tag(hash);
+  entries_[slot].value = value;
+  ++size_;
+  return true;
+}
+
+template <size_t SIZE>
+int HashIndex<SIZE>::find(uint32_t hash,
+  size_t & probe)
+{
+  uint16_t hash_tag = tag(hash);
+  while (probe < SIZE)
+  {
+    Entry & entry = entries_[(hash + probe) & (SIZE - 1)];
+    ++probe;
+    if (entry.value < 0)
+    {
+      return -1;
+    }
+    if (entry.tag == hash_tag)
+    {
+      return entry.value;
+    }
+  }
+  return -1;
+}
+
+template <size_t SIZE>
+size_t HashIndex<SIZE>::size()
+{
+  return size_;
+}
+
+// private
+template <size_t SIZE>
+uint16_t HashIndex<SIZE>::tag(uint32_t hash)
+{
+  return hash >> 16;
+}
+
+}
+#endif
@@ -0,0 +1,69 @@
+// ----------------------------------------------------------------------------
+// HashStream.cpp
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#include "HashStream.h"
+
+
+namespace modular_server
+{
+// public
+HashStream::HashStream()
+{
+  reset();
+}
+
+size_t HashStream::write(uint8_t byte)
+{
+  hash_ ^= byte;
+  hash_ *= 16777619UL;
+  return 1;
+}
+
+int HashStream::available()
+{
+  return 0;
+}
+
+int HashStream::read()
+{
+  return -1;
+}
+
+int HashStream::peek()
+{
+  return -1;
+}
+
+void HashStream::flush()
+{
+}
+
+// private
+void HashStream::reset()
+{
+  hash_ = 2166136261UL;
+}
+
+uint32_t HashStream::getHash()
+{
+  return hash_;
+}
+
+void HashStream::hashToString(uint32_t hash,
+  char * destination)
+{
+  // fixed width lowercase hex so hashes compare as plain strings
+  const char hex_digits[] = "0123456789abcdef";
+  for (size_t i=0; i<(constants::STRING_LENGTH_API_HASH - 1); ++i)
+  {
+    destination[constants::STRING_LENGTH_API_HASH - 2 - i] = hex_digits[hash & 0xF];
+    hash >>= 4;
+  }
+  destination[constants::STRING_LENGTH_API_HASH - 1] = '\0';
+}
+
+}
@@ -0,0 +1,42 @@
+// ----------------------------------------------------------------------------
+// HashStream.h
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_HASH_STREAM_H_
+#define _MODULAR_SERVER_HASH_STREAM_H_
+#include <Arduino.h>
+
+#include "Constants.h"
+
+
+namespace modular_server
+{
+// Write only stream that keeps a running FNV-1a hash of everything written
+// to it, so a serialization can be hashed without being stored.
+class HashStream : public Stream
+{
+public:
+  HashStream();
+
+  size_t write(uint8_t byte);
+  using Print::write;
+  int available();
+  int read();
+  int peek();
+  void flush();
+
+private:
+  uint32_t hash_;
+
+  void reset();
+  uint32_t getHash();
+  static void hashToString(uint32_t hash,
+    char * destination);
+  friend class Server;
+};
+}
+
+#endif
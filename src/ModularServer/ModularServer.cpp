@@ -20,9 +20,19 @@ void ModularServer::setup()
 }
 
 // Streams
-void ModularServer::addServerStream(Stream & stream)
+ServerStream & ModularServer::addServerStream(Stream & stream)
 {
-  server_.addServerStream(stream);
+  return server_.addServerStream(stream);
+}
+
+ServerStream & ModularServer::serverStream(Stream & stream)
+{
+  return server_.serverStream(stream);
+}
+
+void ModularServer::setRequestsPerCallMax(size_t requests_per_call_max)
+{
+  server_.setRequestsPerCallMax(requests_per_call_max);
 }
 
 // Device ID
@@ -128,4 +138,15 @@ void ModularServer::handleServerRequests()
 {
   server_.handleRequest();
 }
+
+void ModularServer::enableStableMethodIds()
+{
+  server_.enableStableMethodIds();
+}
+
+void ModularServer::disableStableMethodIds()
+{
+  server_.disableStableMethodIds();
+}
+
 }
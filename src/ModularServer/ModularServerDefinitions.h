@@ -44,6 +44,25 @@ void ModularServer::addFirmware(const FirmwareInfo & firmware_info,
     callbacks);
 }
 
+template <size_t PROPERTIES_MAX_SIZE,
+  size_t PARAMETERS_MAX_SIZE,
+  size_t FUNCTIONS_MAX_SIZE,
+  size_t CALLBACKS_MAX_SIZE>
+void ModularServer::addFirmware(const FirmwareInfo & firmware_info,
+  Property (&properties)[PROPERTIES_MAX_SIZE],
+  Parameter (&parameters)[PARAMETERS_MAX_SIZE],
+  Function (&functions)[FUNCTIONS_MAX_SIZE],
+  Callback (&callbacks)[CALLBACKS_MAX_SIZE],
+  const ElementTables & element_tables)
+{
+  server_.addFirmware(firmware_info,
+    properties,
+    parameters,
+    functions,
+    callbacks,
+    element_tables);
+}
+
 // Properties
 template <typename T>
 Property & ModularServer::createProperty(const ConstantString & property_name,
@@ -60,6 +79,23 @@ Property & ModularServer::createProperty(const ConstantString & property_name,
   return server_.createProperty(property_name,default_value);
 }
 
+template <typename T>
+Property & ModularServer::createProperty(const ConstantString & property_name,
+  const T & default_value,
+  PropertyHandle<T> & property_handle)
+{
+  return server_.createProperty(property_name,default_value,property_handle);
+}
+
+template <typename T,
+  size_t N>
+Property & ModularServer::createProperty(const ConstantString & property_name,
+  const T (&default_value)[N],
+  PropertyHandle<T[N]> & property_handle)
+{
+  return server_.createProperty(property_name,default_value,property_handle);
+}
+
 template <typename T>
 void ModularServer::setPropertiesToDefaults(T & firmware_name_array)
 {
@@ -23,10 +23,15 @@ void NamedElement::setName(const ConstantString & name)
 
 bool NamedElement::compareName(const char * name_to_compare)
 {
-  char name_str[name_ptr_->length()+1];
+  size_t name_length = name_ptr_->length();
+  if (strlen(name_to_compare) != name_length)
+  {
+    return false;
+  }
+  char name_str[name_length+1];
   name_str[0] = '\0';
   name_ptr_->copy(name_str);
-  return String(name_str).equalsIgnoreCase(name_to_compare);
+  return (strncasecmp(name_str,name_to_compare,name_length) == 0);
 }
 
 bool NamedElement::compareName(const ConstantString & name_to_compare)
@@ -39,4 +44,24 @@ const ConstantString & NamedElement::getName()
   return *name_ptr_;
 }
 
+uint32_t NamedElement::hashName(const char * name)
+{
+  // FNV-1a over the case folded name so it agrees with compareName
+  uint32_t hash = 2166136261UL;
+  for (const char * c=name; *c; ++c)
+  {
+    hash ^= (uint8_t)tolower(*c);
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+uint32_t NamedElement::hashName(const ConstantString & name)
+{
+  char name_str[name.length()+1];
+  name_str[0] = '\0';
+  name.copy(name_str);
+  return hashName(name_str);
+}
+
 }
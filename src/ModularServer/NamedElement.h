@@ -25,6 +25,9 @@ public:
   bool compareName(const ConstantString & name_to_compare);
   const ConstantString & getName();
 
+  static uint32_t hashName(const char * name);
+  static uint32_t hashName(const ConstantString & name);
+
 private:
   const ConstantString * name_ptr_;
 
@@ -28,6 +28,7 @@ void Parameter::setTypeLong()
   {
     array_element_type_ = JsonStream::LONG_TYPE;
   }
+  compileValidator();
 }
 
 void Parameter::setTypeDouble()
@@ -40,6 +41,7 @@ void Parameter::setTypeDouble()
   {
     array_element_type_ = JsonStream::DOUBLE_TYPE;
   }
+  compileValidator();
 }
 
 void Parameter::setTypeBool()
@@ -52,6 +54,7 @@ void Parameter::setTypeBool()
   {
     array_element_type_ = JsonStream::BOOL_TYPE;
   }
+  compileValidator();
 }
 
 void Parameter::setTypeString()
@@ -65,6 +68,7 @@ void Parameter::setTypeString()
   {
     array_element_type_ = JsonStream::STRING_TYPE;
   }
+  compileValidator();
 }
 
 void Parameter::setTypeObject()
@@ -77,6 +81,7 @@ void Parameter::setTypeObject()
   {
     array_element_type_ = JsonStream::OBJECT_TYPE;
   }
+  compileValidator();
 }
 
 void Parameter::setTypeArray()
@@ -86,6 +91,7 @@ void Parameter::setTypeArray()
     array_element_type_ = type_;
     type_ = JsonStream::ARRAY_TYPE;
   }
+  compileValidator();
 }
 
 void Parameter::setTypeAny()
@@ -98,6 +104,7 @@ void Parameter::setTypeAny()
   {
     array_element_type_ = JsonStream::ANY_TYPE;
   }
+  compileValidator();
 }
 
 void Parameter::setType(JsonStream::JsonTypes type)
@@ -110,11 +117,13 @@ void Parameter::setType(JsonStream::JsonTypes type)
   {
     array_element_type_ = type;
   }
+  compileValidator();
 }
 
 void Parameter::setUnits(const ConstantString & units)
 {
   units_ptr_ = &units;
+  ++change_count_;
 }
 
 void Parameter::setRange(double min,
@@ -124,6 +133,7 @@ void Parameter::setRange(double min,
   max_.d = max;
   setTypeDouble();
   range_is_set_ = true;
+  compileValidator();
 }
 
 void Parameter::setRange(float min,
@@ -133,6 +143,7 @@ void Parameter::setRange(float min,
   max_.d = (double)max;
   setTypeDouble();
   range_is_set_ = true;
+  compileValidator();
 }
 
 void Parameter::setRange(constants::NumberType min,
@@ -154,11 +165,13 @@ void Parameter::setRange(constants::NumberType min,
       array_length_max_ = max_value_count;
     }
   }
+  compileValidator();
 }
 
 void Parameter::removeRange()
 {
   range_is_set_ = false;
+  compileValidator();
 }
 
 void Parameter::setArrayLengthRange(size_t array_length_min,
@@ -194,11 +207,13 @@ void Parameter::setArrayLengthRange(size_t array_length_min,
       array_length_max_ = max_value_count;
     }
   }
+  compileValidator();
 }
 
 void Parameter::removeArrayLengthRange()
 {
   array_length_range_is_set_ = false;
+  compileValidator();
 }
 
 void Parameter::setSubset(constants::SubsetMemberType * subset,
@@ -207,6 +222,12 @@ void Parameter::setSubset(constants::SubsetMemberType * subset,
 {
   subset_.setStorage(subset,max_size,size);
   subset_is_set_ = true;
+  // storage that only grew by one appended value, as when pins are created,
+  // is indexed in place instead of rebuilt
+  if (!subset_index_ptr_ || !subset_index_ptr_->append(subset_,subsetHasStrings()))
+  {
+    updateSubsetIndex();
+  }
 
   if (array_length_range_is_set_)
   {
@@ -220,12 +241,14 @@ void Parameter::setSubset(constants::SubsetMemberType * subset,
       array_length_max_ = max_value_count;
     }
   }
+  compileValidator();
 }
 
 void Parameter::setSubset(Vector<constants::SubsetMemberType> & subset)
 {
   subset_ = subset;
   subset_is_set_ = true;
+  updateSubsetIndex();
 
   if (array_length_range_is_set_)
   {
@@ -239,19 +262,26 @@ void Parameter::setSubset(Vector<constants::SubsetMemberType> & subset)
       array_length_max_ = max_value_count;
     }
   }
+  compileValidator();
 }
 
 void Parameter::addValueToSubset(constants::SubsetMemberType & value)
 {
   if (subset_is_set_)
   {
+    ++change_count_;
     subset_.push_back(value);
+    if (subset_index_ptr_ && !subset_index_ptr_->append(subset_,subsetHasStrings()))
+    {
+      updateSubsetIndex();
+    }
   }
 }
 
 void Parameter::removeSubset()
 {
   subset_is_set_ = false;
+  compileValidator();
 }
 
 size_t Parameter::getSubsetSize()
@@ -264,6 +294,19 @@ size_t Parameter::getSubsetMaxSize()
   return subset_.max_size();
 }
 
+void Parameter::setSubsetIndex(SubsetIndex & subset_index)
+{
+  subset_index_ptr_ = &subset_index;
+  updateSubsetIndex();
+  ++change_count_;
+}
+
+void Parameter::removeSubsetIndex()
+{
+  subset_index_ptr_ = NULL;
+  ++change_count_;
+}
+
 template <>
 bool Parameter::getValue<long>(long & value)
 {
@@ -272,7 +315,7 @@ bool Parameter::getValue<long>(long & value)
     (getType() == JsonStream::BOOL_TYPE) ||
     (getType() == JsonStream::ANY_TYPE))
   {
-    long v = get_value_functor_(getName());
+    long v = getRequestLong();
     value = v;
     return true;
   }
@@ -287,7 +330,7 @@ bool Parameter::getValue<double>(double & value)
     (getType() == JsonStream::BOOL_TYPE) ||
     (getType() == JsonStream::ANY_TYPE))
   {
-    double v = get_value_functor_(getName());
+    double v = getRequestDouble();
     value = v;
     return true;
   }
@@ -302,7 +345,7 @@ bool Parameter::getValue<float>(float & value)
     (getType() == JsonStream::BOOL_TYPE) ||
     (getType() == JsonStream::ANY_TYPE))
   {
-    double v = get_value_functor_(getName());
+    double v = getRequestDouble();
     value = v;
     return true;
   }
@@ -317,7 +360,7 @@ bool Parameter::getValue<bool>(bool & value)
     (getType() == JsonStream::BOOL_TYPE) ||
     (getType() == JsonStream::ANY_TYPE))
   {
-    bool v = get_value_functor_(getName());
+    bool v = getRequestBool();
     value = v;
     return true;
   }
@@ -331,7 +374,7 @@ bool Parameter::getValue(const char * & value)
     value = NULL;
     return false;
   }
-  value = get_value_functor_(getName());
+  value = getRequestString();
   return true;
 }
 
@@ -341,7 +384,7 @@ bool Parameter::getValue(ArduinoJson::JsonArray & value)
   {
     return false;
   }
-  value = get_value_functor_(getName());
+  value = getRequestValue();
   return true;
 }
 
@@ -351,7 +394,7 @@ bool Parameter::getValue(ArduinoJson::JsonObject & value)
   {
     return false;
   }
-  value = get_value_functor_(getName());
+  value = getRequestValue();
   return true;
 }
 
@@ -362,8 +405,17 @@ bool Parameter::getValue(const ConstantString * & value)
     value = NULL;
     return false;
   }
-  const char * string_value = get_value_functor_(getName());
-  int subset_value_index = findSubsetValueIndex(string_value);
+  // the subset index was already found when the argument was checked
+  int subset_value_index;
+  if (argument_ptr_ && (argument_ptr_->type == JsonStream::STRING_TYPE))
+  {
+    subset_value_index = argument_ptr_->subset_index;
+  }
+  else
+  {
+    const char * string_value = getRequestValue();
+    subset_value_index = findSubsetValueIndex(string_value);
+  }
   if (subset_value_index < 0)
   {
     value = NULL;
@@ -397,6 +449,7 @@ Parameter::Parameter(const ConstantString & name)
 
 void Parameter::setup(const ConstantString & name)
 {
+  change_count_ = 0;
   setName(name);
   setUnits(constants::empty_constant_string);
   type_ = JsonStream::LONG_TYPE;
@@ -404,6 +457,9 @@ void Parameter::setup(const ConstantString & name)
   range_is_set_ = false;
   array_length_range_is_set_ = false;
   subset_is_set_ = false;
+  subset_index_ptr_ = NULL;
+  argument_ptr_ = NULL;
+  compileValidator();
 }
 
 const ConstantString & Parameter::getUnits()
@@ -501,11 +557,29 @@ bool Parameter::subsetIsSet()
   return subset_is_set_;
 }
 
+bool Parameter::subsetHasStrings()
+{
+  return ((type_ == JsonStream::STRING_TYPE) ||
+    ((type_ == JsonStream::ARRAY_TYPE) && (array_element_type_ == JsonStream::STRING_TYPE)));
+}
+
+void Parameter::updateSubsetIndex()
+{
+  if (subset_index_ptr_ && subset_is_set_)
+  {
+    subset_index_ptr_->build(subset_,subsetHasStrings());
+  }
+}
+
 int Parameter::findSubsetValueIndex(long value)
 {
   int value_index = -1;
   if (subsetIsSet())
   {
+    if (subset_index_ptr_ && subset_index_ptr_->indexes(subset_,false))
+    {
+      return subset_index_ptr_->find(subset_,value);
+    }
     for (size_t i=0; i<subset_.size(); ++i)
     {
       if (value == subset_[i].l)
@@ -523,6 +597,10 @@ int Parameter::findSubsetValueIndex(const char * value)
   int value_index = -1;
   if (subsetIsSet())
   {
+    if (subset_index_ptr_ && subset_index_ptr_->indexes(subset_,true))
+    {
+      return subset_index_ptr_->find(subset_,value);
+    }
     for (size_t i=0; i<subset_.size(); ++i)
     {
       if (value == *subset_[i].cs_ptr)
@@ -590,6 +668,295 @@ Vector<constants::SubsetMemberType> & Parameter::getSubset()
   return subset_;
 }
 
+void Parameter::compileValidator()
+{
+  // every change to the type, range, subset or array length range
+  // recompiles the validator, so this also counts those changes
+  ++change_count_;
+  validator_.clear();
+  element_validator_.clear();
+
+  JsonStream::JsonTypes type = type_;
+  Array<parameter::ValidatorOp,parameter::VALIDATOR_OP_COUNT_MAX> * validator_ptr = &validator_;
+  bool element = (type_ == JsonStream::ARRAY_TYPE);
+  if (element)
+  {
+    validator_.push_back(parameter::CHECK_ARRAY_OP);
+    if (array_length_range_is_set_)
+    {
+      validator_.push_back(parameter::ARRAY_LENGTH_OP);
+    }
+    type = array_element_type_;
+    validator_ptr = &element_validator_;
+  }
+
+  switch (type)
+  {
+    case JsonStream::LONG_TYPE:
+    {
+      validator_ptr->push_back(element ? parameter::DECODE_LONG_OP : parameter::CHECK_LONG_OP);
+      if (subset_is_set_)
+      {
+        validator_ptr->push_back(parameter::LONG_SUBSET_OP);
+      }
+      if (range_is_set_)
+      {
+        validator_ptr->push_back(parameter::LONG_RANGE_OP);
+      }
+      break;
+    }
+    case JsonStream::DOUBLE_TYPE:
+    {
+      validator_ptr->push_back(element ? parameter::DECODE_DOUBLE_OP : parameter::CHECK_DOUBLE_OP);
+      if (range_is_set_)
+      {
+        validator_ptr->push_back(parameter::DOUBLE_RANGE_OP);
+      }
+      break;
+    }
+    case JsonStream::BOOL_TYPE:
+    {
+      if (!element)
+      {
+        validator_ptr->push_back(parameter::CHECK_BOOL_OP);
+      }
+      break;
+    }
+    case JsonStream::STRING_TYPE:
+    {
+      validator_ptr->push_back(element ? parameter::DECODE_STRING_OP : parameter::CHECK_STRING_OP);
+      if (subset_is_set_)
+      {
+        validator_ptr->push_back(parameter::STRING_SUBSET_OP);
+      }
+      break;
+    }
+    case JsonStream::OBJECT_TYPE:
+    {
+      if (!element)
+      {
+        validator_ptr->push_back(parameter::CHECK_OBJECT_OP);
+      }
+      break;
+    }
+    default:
+    {
+      break;
+    }
+  }
+
+  // elements are only visited when there is more to do than decode them,
+  // and arrays with only a range to check get a single bulk pass
+  if ((element_validator_.size() == 2) && (element_validator_[1] == parameter::LONG_RANGE_OP))
+  {
+    validator_.push_back(parameter::ARRAY_LONG_RANGE_OP);
+  }
+  else if ((element_validator_.size() == 2) && (element_validator_[1] == parameter::DOUBLE_RANGE_OP))
+  {
+    validator_.push_back(parameter::ARRAY_DOUBLE_RANGE_OP);
+  }
+  else if (element_validator_.size() > 1)
+  {
+    validator_.push_back(parameter::ARRAY_ELEMENTS_OP);
+  }
+}
+
+uint16_t Parameter::getChangeCount()
+{
+  return change_count_;
+}
+
+parameter::ValidatorResult Parameter::validate(ArduinoJson::JsonVariant json_value,
+  Argument & argument)
+{
+  // decode the argument once here so handlers do not convert it again, any
+  // other type is read through the json variant
+  argument.type = JsonStream::ANY_TYPE;
+  argument.subset_index = -1;
+  argument.element_index = -1;
+  argument.json_variant = json_value;
+  return runValidator(validator_,json_value,argument);
+}
+
+parameter::ValidatorResult Parameter::runValidator(Array<parameter::ValidatorOp,parameter::VALIDATOR_OP_COUNT_MAX> & validator,
+  ArduinoJson::JsonVariant json_value,
+  Argument & argument)
+{
+  for (size_t i=0; i<validator.size(); ++i)
+  {
+    switch (validator[i])
+    {
+      case parameter::CHECK_LONG_OP:
+      {
+        if (!json_value.is<signed long>())
+        {
+          return parameter::INCORRECT_TYPE;
+        }
+        argument.type = JsonStream::LONG_TYPE;
+        argument.l = json_value.as<signed long>();
+        break;
+      }
+      case parameter::CHECK_DOUBLE_OP:
+      {
+        if (!json_value.is<double>())
+        {
+          return parameter::INCORRECT_TYPE;
+        }
+        argument.type = JsonStream::DOUBLE_TYPE;
+        argument.d = json_value.as<double>();
+        break;
+      }
+      case parameter::CHECK_BOOL_OP:
+      {
+        if (!json_value.is<bool>())
+        {
+          return parameter::INCORRECT_TYPE;
+        }
+        argument.type = JsonStream::BOOL_TYPE;
+        argument.b = json_value.as<bool>();
+        break;
+      }
+      case parameter::CHECK_STRING_OP:
+      {
+        if (!json_value.is<const char *>())
+        {
+          return parameter::INCORRECT_TYPE;
+        }
+        argument.type = JsonStream::STRING_TYPE;
+        argument.s = json_value.as<const char *>();
+        break;
+      }
+      case parameter::CHECK_OBJECT_OP:
+      {
+        if (!json_value.is<ArduinoJson::JsonObject>())
+        {
+          return parameter::INCORRECT_TYPE;
+        }
+        break;
+      }
+      case parameter::CHECK_ARRAY_OP:
+      {
+        if (!json_value.is<ArduinoJson::JsonArray>())
+        {
+          return parameter::INCORRECT_TYPE;
+        }
+        break;
+      }
+      case parameter::DECODE_LONG_OP:
+      {
+        argument.l = json_value.as<long>();
+        break;
+      }
+      case parameter::DECODE_DOUBLE_OP:
+      {
+        argument.d = json_value.as<double>();
+        break;
+      }
+      case parameter::DECODE_STRING_OP:
+      {
+        argument.s = json_value.as<const char *>();
+        break;
+      }
+      case parameter::LONG_SUBSET_OP:
+      {
+        if (findSubsetValueIndex(argument.l) < 0)
+        {
+          return parameter::NOT_IN_SUBSET;
+        }
+        break;
+      }
+      case parameter::LONG_RANGE_OP:
+      {
+        if ((argument.l < min_.l) || (argument.l > max_.l))
+        {
+          return parameter::NOT_IN_RANGE;
+        }
+        break;
+      }
+      case parameter::DOUBLE_RANGE_OP:
+      {
+        if ((argument.d < (min_.d - constants::epsilon)) || (argument.d > (max_.d + constants::epsilon)))
+        {
+          return parameter::NOT_IN_RANGE;
+        }
+        break;
+      }
+      case parameter::STRING_SUBSET_OP:
+      {
+        if (argument.s)
+        {
+          argument.subset_index = findSubsetValueIndex(argument.s);
+        }
+        if (argument.subset_index < 0)
+        {
+          return parameter::NOT_IN_SUBSET;
+        }
+        break;
+      }
+      case parameter::ARRAY_LENGTH_OP:
+      {
+        if (!arrayLengthInRange(json_value.size()))
+        {
+          return parameter::ARRAY_LENGTH_NOT_IN_RANGE;
+        }
+        break;
+      }
+      case parameter::ARRAY_ELEMENTS_OP:
+      {
+        Argument element_argument;
+        int element_index = 0;
+        for (ArduinoJson::JsonVariant element_value : json_value.as<ArduinoJson::JsonArray>())
+        {
+          element_argument.subset_index = -1;
+          parameter::ValidatorResult result = runValidator(element_validator_,element_value,element_argument);
+          if (result != parameter::VALID)
+          {
+            argument.element_index = element_index;
+            return result;
+          }
+          ++element_index;
+        }
+        break;
+      }
+      case parameter::ARRAY_LONG_RANGE_OP:
+      {
+        const long min = min_.l;
+        const long max = max_.l;
+        int element_index = 0;
+        for (ArduinoJson::JsonVariant element_value : json_value.as<ArduinoJson::JsonArray>())
+        {
+          long value = element_value.as<long>();
+          if ((value < min) || (value > max))
+          {
+            argument.element_index = element_index;
+            return parameter::NOT_IN_RANGE;
+          }
+          ++element_index;
+        }
+        break;
+      }
+      case parameter::ARRAY_DOUBLE_RANGE_OP:
+      {
+        const double min = min_.d - constants::epsilon;
+        const double max = max_.d + constants::epsilon;
+        int element_index = 0;
+        for (ArduinoJson::JsonVariant element_value : json_value.as<ArduinoJson::JsonArray>())
+        {
+          double value = element_value.as<double>();
+          if ((value < min) || (value > max))
+          {
+            argument.element_index = element_index;
+            return parameter::NOT_IN_RANGE;
+          }
+          ++element_index;
+        }
+        break;
+      }
+    }
+  }
+  return parameter::VALID;
+}
+
 void Parameter::writeApi(Response & response,
   bool write_name_only,
   bool write_method_type,
@@ -793,4 +1160,91 @@ void Parameter::writeApi(Response & response,
   }
 }
 
+void Parameter::setArgument(Argument & argument)
+{
+  argument_ptr_ = &argument;
+}
+
+void Parameter::clearArgument()
+{
+  argument_ptr_ = NULL;
+}
+
+ArduinoJson::JsonVariant Parameter::getRequestValue()
+{
+  // the argument is set while the request is checked, so handlers holding a
+  // parameter reference read it without looking the parameter up by name
+  if (argument_ptr_)
+  {
+    return argument_ptr_->json_variant;
+  }
+  return get_value_functor_(getName());
+}
+
+long Parameter::getRequestLong()
+{
+  if (argument_ptr_)
+  {
+    switch (argument_ptr_->type)
+    {
+      case JsonStream::LONG_TYPE:
+        return argument_ptr_->l;
+      case JsonStream::DOUBLE_TYPE:
+        return argument_ptr_->d;
+      case JsonStream::BOOL_TYPE:
+        return argument_ptr_->b;
+      default:
+        break;
+    }
+  }
+  return getRequestValue();
+}
+
+double Parameter::getRequestDouble()
+{
+  if (argument_ptr_)
+  {
+    switch (argument_ptr_->type)
+    {
+      case JsonStream::LONG_TYPE:
+        return argument_ptr_->l;
+      case JsonStream::DOUBLE_TYPE:
+        return argument_ptr_->d;
+      case JsonStream::BOOL_TYPE:
+        return argument_ptr_->b;
+      default:
+        break;
+    }
+  }
+  return getRequestValue();
+}
+
+bool Parameter::getRequestBool()
+{
+  if (argument_ptr_)
+  {
+    switch (argument_ptr_->type)
+    {
+      case JsonStream::LONG_TYPE:
+        return argument_ptr_->l;
+      case JsonStream::DOUBLE_TYPE:
+        return argument_ptr_->d;
+      case JsonStream::BOOL_TYPE:
+        return argument_ptr_->b;
+      default:
+        break;
+    }
+  }
+  return getRequestValue();
+}
+
+const char * Parameter::getRequestString()
+{
+  if (argument_ptr_ && (argument_ptr_->type == JsonStream::STRING_TYPE))
+  {
+    return argument_ptr_->s;
+  }
+  return getRequestValue();
+}
+
 }
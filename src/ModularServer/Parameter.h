@@ -10,17 +10,74 @@
 #include <Arduino.h>
 #include <ConstantVariable.h>
 #include <JsonStream.h>
+#include <Array.h>
 #include <Vector.h>
 #include <Functor.h>
 #include <ArduinoJson.h>
 
 #include "FirmwareElement.h"
+#include "SubsetIndex.h"
 #include "Response.h"
 #include "Constants.h"
 
 
 namespace modular_server
 {
+namespace parameter
+{
+// Validation steps compiled from the parameter type, range, subset and
+// array length settings, so each request argument runs straight through
+// only the checks that apply to it. Check ops test the json type before
+// decoding, decode ops are used for array elements, which are not type
+// checked.
+enum ValidatorOp
+{
+  CHECK_LONG_OP,
+  CHECK_DOUBLE_OP,
+  CHECK_BOOL_OP,
+  CHECK_STRING_OP,
+  CHECK_OBJECT_OP,
+  CHECK_ARRAY_OP,
+  DECODE_LONG_OP,
+  DECODE_DOUBLE_OP,
+  DECODE_STRING_OP,
+  LONG_SUBSET_OP,
+  LONG_RANGE_OP,
+  DOUBLE_RANGE_OP,
+  STRING_SUBSET_OP,
+  ARRAY_LENGTH_OP,
+  ARRAY_ELEMENTS_OP,
+  ARRAY_LONG_RANGE_OP,
+  ARRAY_DOUBLE_RANGE_OP,
+};
+enum{VALIDATOR_OP_COUNT_MAX=3};
+
+enum ValidatorResult
+{
+  VALID,
+  INCORRECT_TYPE,
+  NOT_IN_SUBSET,
+  NOT_IN_RANGE,
+  ARRAY_LENGTH_NOT_IN_RANGE,
+};
+}
+
+// Request argument decoded once while its parameter is checked
+struct Argument
+{
+  JsonStream::JsonTypes type;
+  union
+  {
+    long l;
+    double d;
+    bool b;
+    const char * s;
+  };
+  int subset_index;
+  int element_index;
+  ArduinoJson::JsonVariant json_variant;
+};
+
 class Parameter : private FirmwareElement
 {
 public:
@@ -61,6 +118,8 @@ public:
   void removeSubset();
   size_t getSubsetSize();
   size_t getSubsetMaxSize();
+  void setSubsetIndex(SubsetIndex & subset_index);
+  void removeSubsetIndex();
 
   template <typename T>
   bool getValue(T & value);
@@ -88,6 +147,11 @@ private:
   bool array_length_range_is_set_;
   Vector<constants::SubsetMemberType> subset_;
   bool subset_is_set_;
+  SubsetIndex * subset_index_ptr_;
+  Array<parameter::ValidatorOp,parameter::VALIDATOR_OP_COUNT_MAX> validator_;
+  Array<parameter::ValidatorOp,parameter::VALIDATOR_OP_COUNT_MAX> element_validator_;
+  Argument * argument_ptr_;
+  uint16_t change_count_;
   Parameter(const ConstantString & name);
   void setup(const ConstantString & name);
   const ConstantString & getUnits();
@@ -105,6 +169,8 @@ private:
   bool arrayLengthRangeIsSet();
   bool arrayLengthInRange(size_t array_length);
   bool subsetIsSet();
+  bool subsetHasStrings();
+  void updateSubsetIndex();
   int findSubsetValueIndex(long value);
   int findSubsetValueIndex(const char * value);
   int findSubsetValueIndex(const ConstantString * value);
@@ -112,17 +178,32 @@ private:
   bool valueInSubset(const char * value);
   bool valueInSubset(const ConstantString * value);
   Vector<constants::SubsetMemberType> & getSubset();
+  void compileValidator();
+  uint16_t getChangeCount();
+  parameter::ValidatorResult validate(ArduinoJson::JsonVariant json_value,
+    Argument & argument);
+  parameter::ValidatorResult runValidator(Array<parameter::ValidatorOp,parameter::VALIDATOR_OP_COUNT_MAX> & validator,
+    ArduinoJson::JsonVariant json_value,
+    Argument & argument);
   void writeApi(Response & response,
     bool write_name_only,
     bool write_method_type,
     bool is_property,
     bool write_firmware,
     bool write_instance_details);
+  void setArgument(Argument & argument);
+  void clearArgument();
+  ArduinoJson::JsonVariant getRequestValue();
+  long getRequestLong();
+  double getRequestDouble();
+  bool getRequestBool();
+  const char * getRequestString();
   static Functor1wRet<const ConstantString &,ArduinoJson::JsonVariant> get_value_functor_;
   friend class Property;
   friend class Function;
   friend class Callback;
   friend class Server;
+  friend class PropertyHandleBase;
 
 };
 }
@@ -33,6 +33,7 @@ void Parameter::setRange(T min,
       array_length_max_ = max_value_count;
     }
   }
+  compileValidator();
 }
 
 template <size_t MAX_SIZE>
@@ -41,6 +42,7 @@ void Parameter::setSubset(constants::SubsetMemberType (&subset)[MAX_SIZE],
 {
   subset_.setStorage(subset,size);
   subset_is_set_ = true;
+  updateSubsetIndex();
 
   if (array_length_range_is_set_)
   {
@@ -54,6 +56,7 @@ void Parameter::setSubset(constants::SubsetMemberType (&subset)[MAX_SIZE],
       array_length_max_ = max_value_count;
     }
   }
+  compileValidator();
 }
 
 template <typename T>
@@ -61,19 +64,19 @@ bool Parameter::getValue(T & value)
 {
   if (getType() == JsonStream::LONG_TYPE)
   {
-    long v = get_value_functor_(getName());
+    long v = getRequestLong();
     value = v;
     return true;
   }
   else if (getType() == JsonStream::DOUBLE_TYPE)
   {
-    double v = get_value_functor_(getName());
+    double v = getRequestDouble();
     value = v;
     return true;
   }
   else if (getType() == JsonStream::BOOL_TYPE)
   {
-    bool v = get_value_functor_(getName());
+    bool v = getRequestBool();
     value = v;
     return true;
   }
@@ -88,7 +91,7 @@ bool Parameter::getValue(Array<U,N> & value)
   {
     return false;
   }
-  ArduinoJson::JsonArray json_array = get_value_functor_(getName());
+  ArduinoJson::JsonArray json_array = getRequestValue();
   value.clear();
   for (ArduinoJson::JsonVariant variant : json_array)
   {
@@ -105,7 +108,7 @@ bool Parameter::getValue(Vector<U> & value)
   {
     return false;
   }
-  ArduinoJson::JsonArray json_array = get_value_functor_(getName());
+  ArduinoJson::JsonArray json_array = getRequestValue();
   value.clear();
   for (ArduinoJson::JsonVariant variant : json_array)
   {
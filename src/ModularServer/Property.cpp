@@ -35,6 +35,21 @@ CONSTANT_STRING(set_element_value_to_default_function_name,"setElementValueToDef
 CONSTANT_STRING(set_all_element_values_function_name,"setAllElementValues");
 CONSTANT_STRING(get_array_length_function_name,"getArrayLength");
 CONSTANT_STRING(set_array_length_function_name,"setArrayLength");
+
+const ConstantString * const function_id_names[FUNCTION_ID_COUNT] =
+{
+  &get_value_function_name,
+  &set_value_function_name,
+  &get_default_value_function_name,
+  &set_value_to_default_function_name,
+  &get_element_value_function_name,
+  &set_element_value_function_name,
+  &get_default_element_value_function_name,
+  &set_element_value_to_default_function_name,
+  &set_all_element_values_function_name,
+  &get_array_length_function_name,
+  &set_array_length_function_name,
+};
 }
 
 Parameter Property::property_parameters_[property::PARAMETER_COUNT_MAX];
@@ -43,8 +58,13 @@ Parameter Property::property_array_parameters_[property::ARRAY_PARAMETER_COUNT_M
 Function Property::property_array_functions_[property::ARRAY_FUNCTION_COUNT_MAX];
 ConcatenatedArray<Parameter,property::FUNCTION_PARAMETER_TYPE_COUNT> Property::parameters_;
 ConcatenatedArray<Function,property::FUNCTION_PARAMETER_TYPE_COUNT> Property::functions_;
+property::FunctionsShape Property::functions_shape_ = property::NO_FUNCTIONS;
+Property * Property::functions_property_ptr_ = NULL;
+uint16_t Property::parameters_change_count_ = 0;
+size_t Property::parameters_array_length_ = 0;
 Response * Property::response_ptr_;
-Functor1wRet<const ConstantString &,ArduinoJson::JsonVariant> Property::get_parameter_value_functor_;
+Functor0 Property::default_value_changed_functor_;
+Functor1<Property &> Property::value_changed_functor_;
 
 Parameter & Property::createParameter(const ConstantString & parameter_name)
 {
@@ -665,6 +685,10 @@ bool Property::setDefaultValue<long>(const long & default_value)
   {
     success = saved_variable_.setDefaultValue(default_value);
   }
+  if (success)
+  {
+    defaultValueChanged();
+  }
   return success;
 }
 
@@ -676,6 +700,10 @@ bool Property::setDefaultValue<double>(const double & default_value)
   {
     success = saved_variable_.setDefaultValue(default_value);
   }
+  if (success)
+  {
+    defaultValueChanged();
+  }
   return success;
 }
 
@@ -687,6 +715,10 @@ bool Property::setDefaultValue<bool>(const bool & default_value)
   {
     success = saved_variable_.setDefaultValue(default_value);
   }
+  if (success)
+  {
+    defaultValueChanged();
+  }
   return success;
 }
 
@@ -699,6 +731,10 @@ bool Property::setDefaultValue<const ConstantString *>(const ConstantString * co
   {
     success = saved_variable_.setDefaultValue(default_value);
   }
+  if (success)
+  {
+    defaultValueChanged();
+  }
   return success;
 }
 
@@ -711,6 +747,10 @@ bool Property::setDefaultValue<ConstantString *>(ConstantString * const & defaul
   {
     success = saved_variable_.setDefaultValue(default_value);
   }
+  if (success)
+  {
+    defaultValueChanged();
+  }
   return success;
 }
 
@@ -1130,6 +1170,11 @@ void Property::addValueToSubset(constants::SubsetMemberType & value)
   parameter_.addValueToSubset(value);
 }
 
+void Property::setSubsetIndex(SubsetIndex & subset_index)
+{
+  parameter_.setSubsetIndex(subset_index);
+}
+
 void Property::attachPreSetValueFunctor(const Functor0 & functor)
 {
   pre_set_value_functor_ = functor;
@@ -1205,6 +1250,10 @@ saved_variable_(default_value)
 void Property::setup()
 {
   functors_enabled_ = true;
+  if (functions_property_ptr_ == this)
+  {
+    functions_property_ptr_ = NULL;
+  }
 }
 
 Parameter & Property::parameter()
@@ -1237,6 +1286,11 @@ bool Property::firmwareNameInArray(ArduinoJson::JsonArray firmware_name_array)
   return parameter_.firmwareNameInArray(firmware_name_array);
 }
 
+bool Property::firmwareInMask(constants::FirmwareMask firmware_mask)
+{
+  return parameter_.firmwareInMask(firmware_mask);
+}
+
 JsonStream::JsonTypes Property::getType()
 {
   return parameter_.getType();
@@ -1315,6 +1369,7 @@ void Property::preSetElementValueFunctor(size_t element_index)
 
 void Property::postSetValueFunctor()
 {
+  valueChanged();
   if (post_set_value_functor_ && functors_enabled_)
   {
     post_set_value_functor_();
@@ -1323,12 +1378,31 @@ void Property::postSetValueFunctor()
 
 void Property::postSetElementValueFunctor(size_t element_index)
 {
+  valueChanged();
   if (post_set_element_value_functor_ && functors_enabled_)
   {
     post_set_element_value_functor_(element_index);
   }
 }
 
+void Property::defaultValueChanged()
+{
+  if (default_value_changed_functor_)
+  {
+    default_value_changed_functor_();
+  }
+}
+
+void Property::valueChanged()
+{
+  // server hook, independent of the attached functors and of
+  // disableFunctors
+  if (value_changed_functor_)
+  {
+    value_changed_functor_(*this);
+  }
+}
+
 void Property::writeValue(Response & response,
   bool write_key,
   bool write_default,
@@ -1686,118 +1760,229 @@ void Property::writeApi(Response & response,
 }
 
 void Property::updateFunctionsAndParameters()
+{
+  // the function tables only depend on the property shape, so they are built
+  // once per shape and then rebound to whichever property is requested
+  property::FunctionsShape functions_shape = getFunctionsShape();
+  if (functions_shape != functions_shape_)
+  {
+    buildFunctionsAndParameters(functions_shape);
+    functions_property_ptr_ = NULL;
+  }
+  bool parameters_stale = false;
+  if (functions_property_ptr_ != this)
+  {
+    bindFunctions();
+    functions_property_ptr_ = this;
+    parameters_stale = true;
+  }
+  // the parameters are copies of this property's parameter sized by its
+  // array length, so they are only refreshed when one of those changed
+  size_t array_length = 0;
+  if (functions_shape_ != property::VALUE_FUNCTIONS)
+  {
+    array_length = getArrayLength();
+  }
+  if (parameters_stale ||
+    (parameters_change_count_ != parameter_.getChangeCount()) ||
+    (parameters_array_length_ != array_length))
+  {
+    updateParameters();
+    parameters_change_count_ = parameter_.getChangeCount();
+    parameters_array_length_ = array_length;
+  }
+}
+
+property::FunctionsShape Property::getFunctionsShape()
 {
   JsonStream::JsonTypes type = getType();
+  if (type == JsonStream::ARRAY_TYPE)
+  {
+    return property::ARRAY_FUNCTIONS;
+  }
+  else if ((type == JsonStream::STRING_TYPE) && stringSavedAsCharArray())
+  {
+    return property::CHAR_ARRAY_FUNCTIONS;
+  }
+  return property::VALUE_FUNCTIONS;
+}
+
+void Property::buildFunctionsAndParameters(property::FunctionsShape functions_shape)
+{
+  functions_shape_ = functions_shape;
 
   // Parameters
   parameters_.clear();
   parameters_.addArray(property_parameters_);
 
-  Parameter & value_parameter = copyParameter(parameter(),property::value_parameter_name);
+  Parameter & value_parameter = createParameter(property::value_parameter_name);
 
   // Functions
   functions_.clear();
   functions_.addArray(property_functions_);
 
-  Function & get_value_function = createFunction(property::get_value_function_name);
-  get_value_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::getValueHandler));
-  get_value_function.setResultType(type);
+  createFunction(property::get_value_function_name);
 
   Function & set_value_function = createFunction(property::set_value_function_name);
-  set_value_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::setValueHandler));
   set_value_function.addParameter(value_parameter);
-  set_value_function.setResultType(type);
 
-  Function & get_default_value_function = createFunction(property::get_default_value_function_name);
+  createFunction(property::get_default_value_function_name);
+
+  createFunction(property::set_value_to_default_function_name);
+
+  if (functions_shape == property::VALUE_FUNCTIONS)
+  {
+    return;
+  }
+
+  // Array Parameters
+  parameters_.addArray(property_array_parameters_);
+
+  Parameter & element_index_parameter = createParameter(property::element_index_parameter_name);
+  element_index_parameter.setTypeLong();
+
+  Parameter & element_value_parameter = createParameter(property::element_value_parameter_name);
+
+  Parameter * array_length_parameter_ptr = NULL;
+  if (functions_shape == property::ARRAY_FUNCTIONS)
+  {
+    array_length_parameter_ptr = &(createParameter(property::array_length_parameter_name));
+    array_length_parameter_ptr->setTypeLong();
+  }
+
+  // Array Functions
+  functions_.addArray(property_array_functions_);
+
+  Function & get_element_value_function = createFunction(property::get_element_value_function_name);
+  get_element_value_function.addParameter(element_index_parameter);
+
+  Function & set_element_value_function = createFunction(property::set_element_value_function_name);
+  set_element_value_function.addParameter(element_index_parameter);
+  set_element_value_function.addParameter(element_value_parameter);
+
+  Function & get_default_element_value_function = createFunction(property::get_default_element_value_function_name);
+  get_default_element_value_function.addParameter(element_index_parameter);
+
+  Function & set_element_value_to_default_function = createFunction(property::set_element_value_to_default_function_name);
+  set_element_value_to_default_function.addParameter(element_index_parameter);
+
+  Function & set_all_element_values_function = createFunction(property::set_all_element_values_function_name);
+  set_all_element_values_function.addParameter(element_value_parameter);
+
+  if (functions_shape == property::ARRAY_FUNCTIONS)
+  {
+    Function & get_array_length_function = createFunction(property::get_array_length_function_name);
+    get_array_length_function.setResultTypeLong();
+
+    Function & set_array_length_function = createFunction(property::set_array_length_function_name);
+    set_array_length_function.addParameter(*array_length_parameter_ptr);
+    set_array_length_function.setResultTypeLong();
+  }
+}
+
+void Property::bindFunctions()
+{
+  JsonStream::JsonTypes type = getType();
+  JsonStream::JsonTypes value_type = type;
+  if (functions_shape_ != property::VALUE_FUNCTIONS)
+  {
+    value_type = getArrayElementType();
+  }
+
+  Function & get_value_function = functions_[property::GET_VALUE_FUNCTION_ID];
+  get_value_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::getValueHandler));
+  get_value_function.setResultType(value_type);
+
+  Function & set_value_function = functions_[property::SET_VALUE_FUNCTION_ID];
+  set_value_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::setValueHandler));
+  set_value_function.setResultType(value_type);
+
+  Function & get_default_value_function = functions_[property::GET_DEFAULT_VALUE_FUNCTION_ID];
   get_default_value_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::getDefaultValueHandler));
-  get_default_value_function.setResultType(type);
+  get_default_value_function.setResultType(value_type);
 
-  Function & set_value_to_default_function = createFunction(property::set_value_to_default_function_name);
+  Function & set_value_to_default_function = functions_[property::SET_VALUE_TO_DEFAULT_FUNCTION_ID];
   set_value_to_default_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::setValueToDefaultHandler));
-  set_value_to_default_function.setResultType(type);
+  set_value_to_default_function.setResultType(value_type);
 
-  if ((type == JsonStream::ARRAY_TYPE) || ((type == JsonStream::STRING_TYPE) && stringSavedAsCharArray()))
+  if (functions_shape_ == property::VALUE_FUNCTIONS)
   {
-    JsonStream::JsonTypes array_element_type = getArrayElementType();
+    return;
+  }
 
-    // Update Function Result Type
-    get_value_function.setResultType(array_element_type);
-    set_value_function.setResultType(array_element_type);
-    get_default_value_function.setResultType(array_element_type);
-    set_value_to_default_function.setResultType(array_element_type);
+  JsonStream::JsonTypes array_element_type = value_type;
 
-    // Array Parameters
-    parameters_.addArray(property_array_parameters_);
+  // setting char array string elements returns the whole string
+  JsonStream::JsonTypes set_element_type = type;
+  if (functions_shape_ == property::ARRAY_FUNCTIONS)
+  {
+    set_element_type = array_element_type;
+  }
 
-    Parameter & element_index_parameter = createParameter(property::element_index_parameter_name);
-    element_index_parameter.setTypeLong();
-    size_t element_index_min = 0;
-    size_t element_index_max;
-    if (type == JsonStream::ARRAY_TYPE)
-    {
-      element_index_max = getArrayLength() - 1;
-    }
-    else
-    {
-      // leave room for string termination character
-      element_index_max = getArrayLength() - 2;
-    }
-    element_index_parameter.setRange(element_index_min,element_index_max);
+  Function & get_element_value_function = functions_[property::GET_ELEMENT_VALUE_FUNCTION_ID];
+  get_element_value_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::getElementValueHandler));
+  get_element_value_function.setResultType(array_element_type);
 
-    Parameter & element_value_parameter = copyParameter(parameter().getElementParameter(),property::element_value_parameter_name);
+  Function & set_element_value_function = functions_[property::SET_ELEMENT_VALUE_FUNCTION_ID];
+  set_element_value_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::setElementValueHandler));
+  set_element_value_function.setResultType(set_element_type);
 
-    Parameter * array_length_parameter_ptr = NULL;
-    if (type == JsonStream::ARRAY_TYPE)
-    {
-      array_length_parameter_ptr = &(createParameter(property::array_length_parameter_name));
-      array_length_parameter_ptr->setTypeLong();
-      array_length_parameter_ptr->setRange(array_length_min_,array_length_max_);
-    }
+  Function & get_default_element_value_function = functions_[property::GET_DEFAULT_ELEMENT_VALUE_FUNCTION_ID];
+  get_default_element_value_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::getDefaultElementValueHandler));
+  get_default_element_value_function.setResultType(array_element_type);
 
-    // Array Functions
-    functions_.addArray(property_array_functions_);
+  Function & set_element_value_to_default_function = functions_[property::SET_ELEMENT_VALUE_TO_DEFAULT_FUNCTION_ID];
+  set_element_value_to_default_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::setElementValueToDefaultHandler));
+  set_element_value_to_default_function.setResultType(set_element_type);
 
-    Function & get_element_value_function = createFunction(property::get_element_value_function_name);
-    get_element_value_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::getElementValueHandler));
-    get_element_value_function.addParameter(element_index_parameter);
-    get_element_value_function.setResultType(array_element_type);
+  Function & set_all_element_values_function = functions_[property::SET_ALL_ELEMENT_VALUES_FUNCTION_ID];
+  set_all_element_values_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::setAllElementValuesHandler));
+  set_all_element_values_function.setResultType(set_element_type);
 
-    Function & set_element_value_function = createFunction(property::set_element_value_function_name);
-    set_element_value_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::setElementValueHandler));
-    set_element_value_function.addParameter(element_index_parameter);
-    set_element_value_function.addParameter(element_value_parameter);
-    set_element_value_function.setResultType(type);
+  if (functions_shape_ == property::ARRAY_FUNCTIONS)
+  {
+    Function & get_array_length_function = functions_[property::GET_ARRAY_LENGTH_FUNCTION_ID];
+    get_array_length_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::getArrayLengthHandler));
 
-    Function & get_default_element_value_function = createFunction(property::get_default_element_value_function_name);
-    get_default_element_value_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::getDefaultElementValueHandler));
-    get_default_element_value_function.addParameter(element_index_parameter);
-    get_default_element_value_function.setResultType(array_element_type);
+    Function & set_array_length_function = functions_[property::SET_ARRAY_LENGTH_FUNCTION_ID];
+    set_array_length_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::setArrayLengthHandler));
+  }
+}
 
-    Function & set_element_value_to_default_function = createFunction(property::set_element_value_to_default_function_name);
-    set_element_value_to_default_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::setElementValueToDefaultHandler));
-    set_element_value_to_default_function.addParameter(element_index_parameter);
-    set_element_value_to_default_function.setResultType(type);
+void Property::updateParameters()
+{
+  // the functions point at these parameters so they are updated in place
+  Parameter & value_parameter = parameters_[property::VALUE_PARAMETER_ID];
+  value_parameter = parameter();
+  value_parameter.setName(property::value_parameter_name);
 
-    Function & set_all_element_values_function = createFunction(property::set_all_element_values_function_name);
-    set_all_element_values_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::setAllElementValuesHandler));
-    set_all_element_values_function.addParameter(element_value_parameter);
-    set_all_element_values_function.setResultType(type);
+  if (functions_shape_ == property::VALUE_FUNCTIONS)
+  {
+    return;
+  }
 
-    if (type == JsonStream::ARRAY_TYPE)
-    {
-      set_element_value_function.setResultType(array_element_type);
-      set_element_value_to_default_function.setResultType(array_element_type);
-      set_all_element_values_function.setResultType(array_element_type);
+  Parameter & element_index_parameter = parameters_[property::ELEMENT_INDEX_PARAMETER_ID];
+  size_t element_index_min = 0;
+  size_t element_index_max;
+  if (functions_shape_ == property::ARRAY_FUNCTIONS)
+  {
+    element_index_max = getArrayLength() - 1;
+  }
+  else
+  {
+    // leave room for string termination character
+    element_index_max = getArrayLength() - 2;
+  }
+  element_index_parameter.setRange(element_index_min,element_index_max);
 
-      Function & get_array_length_function = createFunction(property::get_array_length_function_name);
-      get_array_length_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::getArrayLengthHandler));
-      get_array_length_function.setResultTypeLong();
+  Parameter & element_value_parameter = parameters_[property::ELEMENT_VALUE_PARAMETER_ID];
+  element_value_parameter = parameter().getElementParameter();
+  element_value_parameter.setName(property::element_value_parameter_name);
 
-      Function & set_array_length_function = createFunction(property::set_array_length_function_name);
-      set_array_length_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::setArrayLengthHandler));
-      set_array_length_function.addParameter(*array_length_parameter_ptr);
-      set_array_length_function.setResultTypeLong();
-    }
+  if (functions_shape_ == property::ARRAY_FUNCTIONS)
+  {
+    Parameter & array_length_parameter = parameters_[property::ARRAY_LENGTH_PARAMETER_ID];
+    array_length_parameter.setRange(array_length_min_,array_length_max_);
   }
 }
 
@@ -1814,19 +1999,19 @@ void Property::setValueHandler()
   {
     case JsonStream::LONG_TYPE:
     {
-      long value = get_parameter_value_functor_(property::value_parameter_name);
+      long value = parameters_[property::VALUE_PARAMETER_ID].getRequestLong();
       setValue(value);
       break;
     }
     case JsonStream::DOUBLE_TYPE:
     {
-      double value = get_parameter_value_functor_(property::value_parameter_name);
+      double value = parameters_[property::VALUE_PARAMETER_ID].getRequestDouble();
       setValue(value);
       break;
     }
     case JsonStream::BOOL_TYPE:
     {
-      bool value = get_parameter_value_functor_(property::value_parameter_name);
+      bool value = parameters_[property::VALUE_PARAMETER_ID].getRequestBool();
       setValue(value);
       break;
     }
@@ -1836,7 +2021,7 @@ void Property::setValueHandler()
     }
     case JsonStream::STRING_TYPE:
     {
-      const char * value = get_parameter_value_functor_(property::value_parameter_name);
+      const char * value = parameters_[property::VALUE_PARAMETER_ID].getRequestString();
       size_t array_length = strlen(value) + 1;
       setValue(value,array_length);
       break;
@@ -1847,7 +2032,7 @@ void Property::setValueHandler()
     }
     case JsonStream::ARRAY_TYPE:
     {
-      ArduinoJson::JsonArray value = get_parameter_value_functor_(property::value_parameter_name);
+      ArduinoJson::JsonArray value = parameters_[property::VALUE_PARAMETER_ID].getRequestValue();
       setValue(value);
       break;
     }
@@ -1875,14 +2060,14 @@ void Property::setValueToDefaultHandler()
 
 void Property::getElementValueHandler()
 {
-  long element_index = get_parameter_value_functor_(property::element_index_parameter_name);
+  long element_index = parameters_[property::ELEMENT_INDEX_PARAMETER_ID].getRequestLong();
   response_ptr_->writeResultKey();
   writeValue(*response_ptr_,false,false,element_index);
 }
 
 void Property::setElementValueHandler()
 {
-  long element_index = get_parameter_value_functor_(property::element_index_parameter_name);
+  long element_index = parameters_[property::ELEMENT_INDEX_PARAMETER_ID].getRequestLong();
 
   JsonStream::JsonTypes type = getType();
   switch (type)
@@ -1919,7 +2104,7 @@ void Property::setElementValueHandler()
         response_ptr_->returnParameterInvalidError(constants::property_element_index_out_of_bounds_error_data);
         return;
       }
-      const char * value = get_parameter_value_functor_(property::element_value_parameter_name);
+      const char * value = parameters_[property::ELEMENT_VALUE_PARAMETER_ID].getRequestString();
       size_t string_length = strlen(value);
       if (string_length >= 1)
       {
@@ -1945,19 +2130,19 @@ void Property::setElementValueHandler()
       {
         case JsonStream::LONG_TYPE:
         {
-          long value = get_parameter_value_functor_(property::element_value_parameter_name);
+          long value = parameters_[property::ELEMENT_VALUE_PARAMETER_ID].getRequestLong();
           setElementValue(element_index,value);
           break;
         }
         case JsonStream::DOUBLE_TYPE:
         {
-          double value = get_parameter_value_functor_(property::element_value_parameter_name);
+          double value = parameters_[property::ELEMENT_VALUE_PARAMETER_ID].getRequestDouble();
           setElementValue(element_index,value);
           break;
         }
         case JsonStream::BOOL_TYPE:
         {
-          bool value = get_parameter_value_functor_(property::element_value_parameter_name);
+          bool value = parameters_[property::ELEMENT_VALUE_PARAMETER_ID].getRequestBool();
           setElementValue(element_index,value);
           break;
         }
@@ -1967,7 +2152,7 @@ void Property::setElementValueHandler()
         }
         case JsonStream::STRING_TYPE:
         {
-          const char * value = get_parameter_value_functor_(property::element_value_parameter_name);
+          const char * value = parameters_[property::ELEMENT_VALUE_PARAMETER_ID].getRequestString();
           setElementValue(element_index,value);
           break;
         }
@@ -1997,14 +2182,14 @@ void Property::setElementValueHandler()
 
 void Property::getDefaultElementValueHandler()
 {
-  long element_index = get_parameter_value_functor_(property::element_index_parameter_name);
+  long element_index = parameters_[property::ELEMENT_INDEX_PARAMETER_ID].getRequestLong();
   response_ptr_->writeResultKey();
   writeValue(*response_ptr_,false,true,element_index);
 }
 
 void Property::setElementValueToDefaultHandler()
 {
-  long element_index = get_parameter_value_functor_(property::element_index_parameter_name);
+  long element_index = parameters_[property::ELEMENT_INDEX_PARAMETER_ID].getRequestLong();
   setElementValueToDefault(element_index);
   response_ptr_->writeResultKey();
   writeValue(*response_ptr_,false,false,-1);
@@ -2038,7 +2223,7 @@ void Property::setAllElementValuesHandler()
         response_ptr_->returnParameterInvalidError(constants::cannot_set_element_in_string_property_with_subset_error_data);
         break;
       }
-      const char * value = get_parameter_value_functor_(property::element_value_parameter_name);
+      const char * value = parameters_[property::ELEMENT_VALUE_PARAMETER_ID].getRequestString();
       size_t string_length = strlen(value);
       if (string_length >= 1)
       {
@@ -2058,19 +2243,19 @@ void Property::setAllElementValuesHandler()
       {
         case JsonStream::LONG_TYPE:
         {
-          long value = get_parameter_value_functor_(property::element_value_parameter_name);
+          long value = parameters_[property::ELEMENT_VALUE_PARAMETER_ID].getRequestLong();
           setAllElementValues(value);
           break;
         }
         case JsonStream::DOUBLE_TYPE:
         {
-          double value = get_parameter_value_functor_(property::element_value_parameter_name);
+          double value = parameters_[property::ELEMENT_VALUE_PARAMETER_ID].getRequestDouble();
           setAllElementValues(value);
           break;
         }
         case JsonStream::BOOL_TYPE:
         {
-          bool value = get_parameter_value_functor_(property::element_value_parameter_name);
+          bool value = parameters_[property::ELEMENT_VALUE_PARAMETER_ID].getRequestBool();
           setAllElementValues(value);
           break;
         }
@@ -2080,7 +2265,7 @@ void Property::setAllElementValuesHandler()
         }
         case JsonStream::STRING_TYPE:
         {
-          const char * value = get_parameter_value_functor_(property::element_value_parameter_name);
+          const char * value = parameters_[property::ELEMENT_VALUE_PARAMETER_ID].getRequestString();
           setAllElementValues(value);
           break;
         }
@@ -2116,7 +2301,7 @@ void Property::getArrayLengthHandler()
 
 void Property::setArrayLengthHandler()
 {
-  long array_length = get_parameter_value_functor_(property::array_length_parameter_name);
+  long array_length = parameters_[property::ARRAY_LENGTH_PARAMETER_ID].getRequestLong();
   setArrayLength(array_length);
 
   array_length = getArrayLength();
@@ -55,6 +55,41 @@ extern ConstantString set_element_value_to_default_function_name;
 extern ConstantString set_all_element_values_function_name;
 extern ConstantString get_array_length_function_name;
 extern ConstantString set_array_length_function_name;
+
+// Function ids are positions in the function table, the array functions
+// always follow the scalar functions in this order
+enum{FUNCTION_ID_COUNT=FUNCTION_COUNT_MAX+ARRAY_FUNCTION_COUNT_MAX};
+extern const ConstantString * const function_id_names[FUNCTION_ID_COUNT];
+enum FunctionId
+{
+  GET_VALUE_FUNCTION_ID,
+  SET_VALUE_FUNCTION_ID,
+  GET_DEFAULT_VALUE_FUNCTION_ID,
+  SET_VALUE_TO_DEFAULT_FUNCTION_ID,
+  GET_ELEMENT_VALUE_FUNCTION_ID,
+  SET_ELEMENT_VALUE_FUNCTION_ID,
+  GET_DEFAULT_ELEMENT_VALUE_FUNCTION_ID,
+  SET_ELEMENT_VALUE_TO_DEFAULT_FUNCTION_ID,
+  SET_ALL_ELEMENT_VALUES_FUNCTION_ID,
+  GET_ARRAY_LENGTH_FUNCTION_ID,
+  SET_ARRAY_LENGTH_FUNCTION_ID,
+};
+enum ParameterId
+{
+  VALUE_PARAMETER_ID,
+  ELEMENT_INDEX_PARAMETER_ID,
+  ELEMENT_VALUE_PARAMETER_ID,
+  ARRAY_LENGTH_PARAMETER_ID,
+};
+
+// Function tables are built once per shape
+enum FunctionsShape
+{
+  NO_FUNCTIONS,
+  VALUE_FUNCTIONS,
+  CHAR_ARRAY_FUNCTIONS,
+  ARRAY_FUNCTIONS,
+};
 }
 
 class Property
@@ -159,6 +194,7 @@ public:
     size_t max_size,
     size_t size);
   void addValueToSubset(constants::SubsetMemberType & value);
+  void setSubsetIndex(SubsetIndex & subset_index);
 
   void attachPreSetValueFunctor(const Functor0 & functor);
   void attachPreSetElementValueFunctor(const Functor1<size_t> & functor);
@@ -174,9 +210,13 @@ private:
   static Function property_array_functions_[property::ARRAY_FUNCTION_COUNT_MAX];
   static ConcatenatedArray<Parameter,property::FUNCTION_PARAMETER_TYPE_COUNT> parameters_;
   static ConcatenatedArray<Function,property::FUNCTION_PARAMETER_TYPE_COUNT> functions_;
+  static property::FunctionsShape functions_shape_;
+  static Property * functions_property_ptr_;
+  static uint16_t parameters_change_count_;
+  static size_t parameters_array_length_;
   static Response * response_ptr_;
-  static Functor1wRet<const ConstantString &,
-    ArduinoJson::JsonVariant> get_parameter_value_functor_;
+  static Functor0 default_value_changed_functor_;
+  static Functor1<Property &> value_changed_functor_;
 
   template <typename T>
   static int findParameterIndex(T const & parameter_name)
@@ -254,6 +294,7 @@ private:
   const ConstantString & getName();
   const ConstantString &  getFirmwareName();
   bool firmwareNameInArray(ArduinoJson::JsonArray firmware_name_array);
+  bool firmwareInMask(constants::FirmwareMask firmware_mask);
   JsonStream::JsonTypes getType();
   JsonStream::JsonTypes getArrayElementType();
   bool rangeIsSet();
@@ -270,6 +311,8 @@ private:
   void preSetElementValueFunctor(size_t element_index);
   void postSetValueFunctor();
   void postSetElementValueFunctor(size_t element_index);
+  void defaultValueChanged();
+  void valueChanged();
   void writeValue(Response & response,
     bool write_key=false,
     bool write_default=false,
@@ -281,6 +324,10 @@ private:
     bool write_function_parameter_details,
     bool write_instance_details);
   void updateFunctionsAndParameters();
+  property::FunctionsShape getFunctionsShape();
+  static void buildFunctionsAndParameters(property::FunctionsShape functions_shape);
+  void bindFunctions();
+  void updateParameters();
 
   // Handlers
   void getValueHandler();
@@ -298,6 +345,9 @@ private:
 
   friend class Callback;
   friend class Server;
+  friend class PropertyHandleBase;
+  template <typename T>
+  friend class PropertyHandle;
 };
 }
 #include "PropertyDefinitions.h"
@@ -426,6 +426,10 @@ bool Property::setDefaultValue(const long (&default_value)[N])
       setArrayLengthRange(0,N);
     }
   }
+  if (success)
+  {
+    defaultValueChanged();
+  }
   return success;
 }
 
@@ -443,6 +447,10 @@ bool Property::setDefaultValue(const double (&default_value)[N])
       setArrayLengthRange(0,N);
     }
   }
+  if (success)
+  {
+    defaultValueChanged();
+  }
   return success;
 }
 
@@ -460,6 +468,10 @@ bool Property::setDefaultValue(const bool (&default_value)[N])
       setArrayLengthRange(0,N);
     }
   }
+  if (success)
+  {
+    defaultValueChanged();
+  }
   return success;
 }
 
@@ -499,6 +511,10 @@ bool Property::setDefaultValue(const char (&default_value)[N])
       }
     }
   }
+  if (success)
+  {
+    defaultValueChanged();
+  }
   return success;
 }
 
@@ -517,6 +533,10 @@ bool Property::setDefaultValue(const ConstantString * const (&default_value)[N])
       setArrayLengthRange(0,N);
     }
   }
+  if (success)
+  {
+    defaultValueChanged();
+  }
   return success;
 }
 
@@ -0,0 +1,63 @@
+// ----------------------------------------------------------------------------
+// PropertyHandle.cpp
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#include "PropertyHandle.h"
+
+
+namespace modular_server
+{
+// public
+bool PropertyHandleBase::valid()
+{
+  return (property_ptr_ != NULL);
+}
+
+Property & PropertyHandleBase::property()
+{
+  return *property_ptr_;
+}
+
+// protected
+PropertyHandleBase::PropertyHandleBase()
+{
+  property_ptr_ = NULL;
+}
+
+JsonStream::JsonTypes PropertyHandleBase::getType(long * value)
+{
+  return JsonStream::LONG_TYPE;
+}
+
+JsonStream::JsonTypes PropertyHandleBase::getType(double * value)
+{
+  return JsonStream::DOUBLE_TYPE;
+}
+
+JsonStream::JsonTypes PropertyHandleBase::getType(bool * value)
+{
+  return JsonStream::BOOL_TYPE;
+}
+
+bool PropertyHandleBase::checkValue(Property & property,
+  const long & value)
+{
+  return (property.parameter_.valueInRange(value) && property.parameter_.valueInSubset(value));
+}
+
+bool PropertyHandleBase::checkValue(Property & property,
+  const double & value)
+{
+  return property.parameter_.valueInRange(value);
+}
+
+bool PropertyHandleBase::checkValue(Property & property,
+  const bool & value)
+{
+  return true;
+}
+
+}
@@ -0,0 +1,73 @@
+// ----------------------------------------------------------------------------
+// PropertyHandle.h
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_PROPERTY_HANDLE_H_
+#define _MODULAR_SERVER_PROPERTY_HANDLE_H_
+#include <Arduino.h>
+#include <JsonStream.h>
+
+#include "Property.h"
+
+
+namespace modular_server
+{
+// Typed access to a long, double or bool property. Handles bound by the
+// createProperty overloads have their type and array length fixed at
+// compile time, handles made from a property check them once, so reads and
+// writes through a valid handle go straight to the saved variable. Writes
+// check values the same way the Property setters do and still call the set
+// value functors.
+class PropertyHandleBase
+{
+public:
+  bool valid();
+  Property & property();
+
+protected:
+  Property * property_ptr_;
+
+  PropertyHandleBase();
+  static JsonStream::JsonTypes getType(long * value);
+  static JsonStream::JsonTypes getType(double * value);
+  static JsonStream::JsonTypes getType(bool * value);
+  static bool checkValue(Property & property,
+    const long & value);
+  static bool checkValue(Property & property,
+    const double & value);
+  static bool checkValue(Property & property,
+    const bool & value);
+};
+
+template <typename T>
+class PropertyHandle : public PropertyHandleBase
+{
+public:
+  PropertyHandle();
+  PropertyHandle(Property & property);
+
+  bool getValue(T & value);
+  bool setValue(const T & value);
+};
+
+template <typename T,
+  size_t N>
+class PropertyHandle<T[N]> : public PropertyHandleBase
+{
+public:
+  PropertyHandle();
+  PropertyHandle(Property & property);
+
+  bool getElementValue(size_t element_index,
+    T & element_value);
+  bool setElementValue(size_t element_index,
+    const T & element_value);
+  size_t getArrayLength();
+};
+}
+#include "PropertyHandleDefinitions.h"
+
+#endif
@@ -0,0 +1,119 @@
+// ----------------------------------------------------------------------------
+// PropertyHandleDefinitions.h
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_PROPERTY_HANDLE_DEFINITIONS_H_
+#define _MODULAR_SERVER_PROPERTY_HANDLE_DEFINITIONS_H_
+
+
+namespace modular_server
+{
+// public
+template <typename T>
+PropertyHandle<T>::PropertyHandle()
+{
+}
+
+template <typename T>
+PropertyHandle<T>::PropertyHandle(Property & property)
+{
+  if (property.getType() == getType((T *)0))
+  {
+    property_ptr_ = &property;
+  }
+}
+
+template <typename T>
+bool PropertyHandle<T>::getValue(T & value)
+{
+  if (!property_ptr_)
+  {
+    return false;
+  }
+  return property_ptr_->saved_variable_.getValue(value);
+}
+
+template <typename T>
+bool PropertyHandle<T>::setValue(const T & value)
+{
+  if (!property_ptr_)
+  {
+    return false;
+  }
+  Property & property = *property_ptr_;
+  bool success = false;
+  property.preSetValueFunctor();
+  if (checkValue(property,value))
+  {
+    success = property.saved_variable_.setValue(value);
+  }
+  property.postSetValueFunctor();
+  return success;
+}
+
+template <typename T,
+  size_t N>
+PropertyHandle<T[N]>::PropertyHandle()
+{
+}
+
+template <typename T,
+  size_t N>
+PropertyHandle<T[N]>::PropertyHandle(Property & property)
+{
+  if ((property.getType() == JsonStream::ARRAY_TYPE) &&
+    (property.getArrayElementType() == getType((T *)0)) &&
+    (property.getArrayLengthMax() == N))
+  {
+    property_ptr_ = &property;
+  }
+}
+
+template <typename T,
+  size_t N>
+bool PropertyHandle<T[N]>::getElementValue(size_t element_index,
+  T & element_value)
+{
+  if (!property_ptr_)
+  {
+    return false;
+  }
+  return property_ptr_->saved_variable_.getElementValue(element_index,element_value);
+}
+
+template <typename T,
+  size_t N>
+bool PropertyHandle<T[N]>::setElementValue(size_t element_index,
+  const T & element_value)
+{
+  if (!property_ptr_)
+  {
+    return false;
+  }
+  Property & property = *property_ptr_;
+  bool success = false;
+  property.preSetElementValueFunctor(element_index);
+  if (checkValue(property,element_value))
+  {
+    success = property.saved_variable_.setElementValue(element_index,element_value);
+  }
+  property.postSetElementValueFunctor(element_index);
+  return success;
+}
+
+template <typename T,
+  size_t N>
+size_t PropertyHandle<T[N]>::getArrayLength()
+{
+  if (!property_ptr_)
+  {
+    return 0;
+  }
+  return property_ptr_->saved_variable_.getArrayLength();
+}
+
+}
+#endif
@@ -0,0 +1,553 @@
+// ----------------------------------------------------------------------------
+// RequestParser.cpp
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#include "RequestParser.h"
+
+
+namespace modular_server
+{
+// public
+RequestParser::RequestParser()
+{
+  position_ = NULL;
+  delimiter_position_ = NULL;
+  delimiter_ = '\0';
+  empty_ = true;
+  compact_ = false;
+  object_ = false;
+  scalar_type_ = JsonStream::NULL_TYPE;
+  scalar_bool_ = false;
+  scalar_string_ = NULL;
+  request_ = NULL;
+  original_offset_ = -1;
+}
+
+bool RequestParser::parse(char * request,
+  ArduinoJson::JsonDocument & json_document)
+{
+  position_ = request;
+  delimiter_position_ = NULL;
+  delimiter_ = '\0';
+  empty_ = false;
+  compact_ = false;
+  object_ = false;
+  terminations_.clear();
+  request_ = request;
+  original_offset_ = -1;
+
+  skipWhitespace();
+  char c = peek();
+  if (c == '\0')
+  {
+    empty_ = true;
+    return false;
+  }
+  if (c == '{')
+  {
+    compact_ = true;
+    object_ = true;
+    return false;
+  }
+
+  ArduinoJson::JsonArray json_array = json_document.to<ArduinoJson::JsonArray>();
+  bool parsed = false;
+  if (c == '[')
+  {
+    compact_ = true;
+    ++position_;
+    parsed = parseArray(json_array,1,']');
+    if (parsed)
+    {
+      skipWhitespace();
+      parsed = (peek() == '\0');
+    }
+  }
+  else
+  {
+    // relaxed syntax is an implicit top level array
+    parsed = parseArray(json_array,0,'\0');
+  }
+  if (!parsed)
+  {
+    restore();
+  }
+  return parsed;
+}
+
+bool RequestParser::empty()
+{
+  return empty_;
+}
+
+bool RequestParser::compact()
+{
+  return compact_;
+}
+
+bool RequestParser::object()
+{
+  return object_;
+}
+
+// private
+char RequestParser::peek()
+{
+  if (position_ == delimiter_position_)
+  {
+    return delimiter_;
+  }
+  return *position_;
+}
+
+void RequestParser::skipWhitespace()
+{
+  while (isWhitespace(peek()))
+  {
+    ++position_;
+  }
+}
+
+void RequestParser::skipSeparators()
+{
+  char c = peek();
+  while (isWhitespace(c) || (c == ','))
+  {
+    ++position_;
+    c = peek();
+  }
+}
+
+bool RequestParser::isWhitespace(char c)
+{
+  return ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n'));
+}
+
+bool RequestParser::isDelimiter(char c,
+  bool key)
+{
+  switch (c)
+  {
+    case '\0':
+    case ',':
+    case '[':
+    case ']':
+    case '{':
+    case '}':
+    case '"':
+      return true;
+    case ':':
+      return key;
+  }
+  return isWhitespace(c);
+}
+
+bool RequestParser::parseArray(ArduinoJson::JsonArray json_array,
+  size_t depth,
+  char close)
+{
+  while (true)
+  {
+    skipSeparators();
+    char c = peek();
+    if (c == close)
+    {
+      if (c != '\0')
+      {
+        ++position_;
+      }
+      return true;
+    }
+    if (c == '\0')
+    {
+      return false;
+    }
+    if (c == '[')
+    {
+      ++position_;
+      if (depth >= constants::REQUEST_NESTING_MAX)
+      {
+        return false;
+      }
+      ArduinoJson::JsonArray nested_array = json_array.createNestedArray();
+      if (nested_array.isNull() || !parseArray(nested_array,depth+1,']'))
+      {
+        return false;
+      }
+    }
+    else if (c == '{')
+    {
+      ++position_;
+      if (depth >= constants::REQUEST_NESTING_MAX)
+      {
+        return false;
+      }
+      ArduinoJson::JsonObject nested_object = json_array.createNestedObject();
+      if (nested_object.isNull() || !parseObject(nested_object,depth+1))
+      {
+        return false;
+      }
+    }
+    else if (!parseScalar(false) || !addScalar(json_array))
+    {
+      return false;
+    }
+  }
+}
+
+bool RequestParser::parseObject(ArduinoJson::JsonObject json_object,
+  size_t depth)
+{
+  while (true)
+  {
+    skipSeparators();
+    char c = peek();
+    if (c == '}')
+    {
+      ++position_;
+      return true;
+    }
+    if (!parseScalar(true))
+    {
+      return false;
+    }
+    const char * key = scalar_string_;
+    skipWhitespace();
+    if (peek() != ':')
+    {
+      return false;
+    }
+    ++position_;
+    skipWhitespace();
+    c = peek();
+    if (c == '[')
+    {
+      ++position_;
+      if (depth >= constants::REQUEST_NESTING_MAX)
+      {
+        return false;
+      }
+      ArduinoJson::JsonArray nested_array = json_object.createNestedArray(key);
+      if (nested_array.isNull() || !parseArray(nested_array,depth+1,']'))
+      {
+        return false;
+      }
+    }
+    else if (c == '{')
+    {
+      ++position_;
+      if (depth >= constants::REQUEST_NESTING_MAX)
+      {
+        return false;
+      }
+      ArduinoJson::JsonObject nested_object = json_object.createNestedObject(key);
+      if (nested_object.isNull() || !parseObject(nested_object,depth+1))
+      {
+        return false;
+      }
+    }
+    else if (!parseScalar(false) || !addScalar(json_object,key))
+    {
+      return false;
+    }
+  }
+}
+
+bool RequestParser::parseScalar(bool key)
+{
+  char c = peek();
+  if (c == '"')
+  {
+    ++position_;
+    return parseQuotedString();
+  }
+  if (isDelimiter(c,key) || (c == ':'))
+  {
+    return false;
+  }
+  char * start = position_;
+  while (!isDelimiter(peek(),key))
+  {
+    ++position_;
+  }
+  char * end = position_;
+  scalar_type_ = JsonStream::STRING_TYPE;
+  scalar_string_ = start;
+  if (!key)
+  {
+    classifyBareWord(start,end);
+  }
+  // the delimiter is still needed by the caller after it is overwritten
+  delimiter_ = *end;
+  delimiter_position_ = end;
+  return terminate(end);
+}
+
+bool RequestParser::parseQuotedString()
+{
+  char * destination = position_;
+  scalar_type_ = JsonStream::STRING_TYPE;
+  scalar_string_ = destination;
+  while (true)
+  {
+    char c = *position_;
+    if (c == '\0')
+    {
+      return false;
+    }
+    ++position_;
+    if (c == '"')
+    {
+      break;
+    }
+    if (c == '\\')
+    {
+      saveOriginal(destination);
+      c = *position_;
+      if (c == '\0')
+      {
+        return false;
+      }
+      ++position_;
+      switch (c)
+      {
+        case 'b':
+          c = '\b';
+          break;
+        case 'f':
+          c = '\f';
+          break;
+        case 'n':
+          c = '\n';
+          break;
+        case 'r':
+          c = '\r';
+          break;
+        case 't':
+          c = '\t';
+          break;
+        case 'u':
+        {
+          long code_point = 0;
+          for (size_t i=0; i<4; ++i)
+          {
+            int value = hexValue(*position_);
+            if (value < 0)
+            {
+              return false;
+            }
+            code_point = (code_point << 4) | value;
+            ++position_;
+          }
+          // six escape characters always encode into at most three bytes
+          if (code_point < 0x80)
+          {
+            *destination++ = code_point;
+          }
+          else if (code_point < 0x800)
+          {
+            *destination++ = 0xC0 | (code_point >> 6);
+            *destination++ = 0x80 | (code_point & 0x3F);
+          }
+          else
+          {
+            *destination++ = 0xE0 | (code_point >> 12);
+            *destination++ = 0x80 | ((code_point >> 6) & 0x3F);
+            *destination++ = 0x80 | (code_point & 0x3F);
+          }
+          continue;
+        }
+      }
+    }
+    *destination++ = c;
+  }
+  return terminate(destination);
+}
+
+void RequestParser::classifyBareWord(const char * start,
+  const char * end)
+{
+  size_t length = end - start;
+  if (matchesLiteral(start,length,"true"))
+  {
+    scalar_type_ = JsonStream::BOOL_TYPE;
+    scalar_bool_ = true;
+    return;
+  }
+  if (matchesLiteral(start,length,"false"))
+  {
+    scalar_type_ = JsonStream::BOOL_TYPE;
+    scalar_bool_ = false;
+    return;
+  }
+  if (matchesLiteral(start,length,"null"))
+  {
+    scalar_type_ = JsonStream::NULL_TYPE;
+    return;
+  }
+
+  bool digit_found = false;
+  bool integer = true;
+  for (const char * p=start; p<end; ++p)
+  {
+    char c = *p;
+    if ((c >= '0') && (c <= '9'))
+    {
+      digit_found = true;
+    }
+    else if ((c == '.') || (c == 'e') || (c == 'E'))
+    {
+      integer = false;
+    }
+    else if ((c != '-') && (c != '+'))
+    {
+      return;
+    }
+  }
+  if (!digit_found)
+  {
+    return;
+  }
+
+  char * number_end;
+  if (integer)
+  {
+    errno = 0;
+    long value = strtol(start,&number_end,10);
+    if ((number_end == end) && (errno != ERANGE))
+    {
+      scalar_type_ = JsonStream::LONG_TYPE;
+      scalar_number_.l = value;
+      return;
+    }
+  }
+  double value = strtod(start,&number_end);
+  if (number_end == end)
+  {
+    scalar_type_ = JsonStream::DOUBLE_TYPE;
+    scalar_number_.d = value;
+  }
+}
+
+bool RequestParser::matchesLiteral(const char * start,
+  size_t length,
+  const char * literal)
+{
+  return ((strlen(literal) == length) && (strncmp(start,literal,length) == 0));
+}
+
+int RequestParser::hexValue(char c)
+{
+  if ((c >= '0') && (c <= '9'))
+  {
+    return c - '0';
+  }
+  if ((c >= 'a') && (c <= 'f'))
+  {
+    return c - 'a' + 10;
+  }
+  if ((c >= 'A') && (c <= 'F'))
+  {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+bool RequestParser::addScalar(ArduinoJson::JsonArray json_array)
+{
+  switch (scalar_type_)
+  {
+    case JsonStream::LONG_TYPE:
+      return json_array.add(scalar_number_.l);
+    case JsonStream::DOUBLE_TYPE:
+      return json_array.add(scalar_number_.d);
+    case JsonStream::BOOL_TYPE:
+      return json_array.add(scalar_bool_);
+    case JsonStream::STRING_TYPE:
+      return json_array.add(scalar_string_);
+    case JsonStream::NULL_TYPE:
+    {
+      size_t size = json_array.size();
+      json_array.add();
+      return (json_array.size() > size);
+    }
+    default:
+      return false;
+  }
+}
+
+bool RequestParser::addScalar(ArduinoJson::JsonObject json_object,
+  const char * key)
+{
+  switch (scalar_type_)
+  {
+    case JsonStream::LONG_TYPE:
+      return json_object[key].set(scalar_number_.l);
+    case JsonStream::DOUBLE_TYPE:
+      return json_object[key].set(scalar_number_.d);
+    case JsonStream::BOOL_TYPE:
+      return json_object[key].set(scalar_bool_);
+    case JsonStream::STRING_TYPE:
+      return json_object[key].set(scalar_string_);
+    case JsonStream::NULL_TYPE:
+    {
+      json_object[key].to<ArduinoJson::JsonVariant>();
+      return json_object.containsKey(key);
+    }
+    default:
+      return false;
+  }
+}
+
+bool RequestParser::terminate(char * position)
+{
+  if (*position == '\0')
+  {
+    return true;
+  }
+  // only overwrite what restore can put back
+  if (terminations_.full())
+  {
+    return false;
+  }
+  Termination termination;
+  termination.position = position;
+  termination.character = *position;
+  terminations_.push_back(termination);
+  *position = '\0';
+  return true;
+}
+
+void RequestParser::saveOriginal(char * position)
+{
+  // decoding escapes rewrites the rest of the request, which terminations
+  // alone cannot undo, so the untouched rest is copied once per request
+  if (original_offset_ >= 0)
+  {
+    return;
+  }
+  original_offset_ = position - request_;
+  strncpy(original_,position,constants::STRING_LENGTH_REQUEST - 1);
+  original_[constants::STRING_LENGTH_REQUEST - 1] = '\0';
+}
+
+void RequestParser::restore()
+{
+  // put the request back together so it can be echoed in the parse error
+  for (size_t i=terminations_.size(); i>0; --i)
+  {
+    Termination & termination = terminations_[i-1];
+    *termination.position = termination.character;
+  }
+  terminations_.clear();
+  if (original_offset_ >= 0)
+  {
+    strcpy(request_ + original_offset_,original_);
+    original_offset_ = -1;
+  }
+}
+
+}
@@ -0,0 +1,86 @@
+// ----------------------------------------------------------------------------
+// RequestParser.h
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_REQUEST_PARSER_H_
+#define _MODULAR_SERVER_REQUEST_PARSER_H_
+#include <Arduino.h>
+#include <errno.h>
+#include <ArduinoJson.h>
+#include <Array.h>
+#include <JsonStream.h>
+
+#include "Constants.h"
+
+
+namespace modular_server
+{
+// Tokenizes a request line in place in a single pass, accepting both json
+// and the relaxed whitespace separated syntax. Strings are stored in the
+// json document as pointers into the request buffer, so the request buffer
+// must outlive the json document contents.
+class RequestParser
+{
+public:
+  RequestParser();
+
+  bool parse(char * request,
+    ArduinoJson::JsonDocument & json_document);
+  bool empty();
+  bool compact();
+  bool object();
+
+private:
+  struct Termination
+  {
+    char * position;
+    char character;
+  };
+  char * position_;
+  char * delimiter_position_;
+  char delimiter_;
+  bool empty_;
+  bool compact_;
+  bool object_;
+  JsonStream::JsonTypes scalar_type_;
+  constants::NumberType scalar_number_;
+  bool scalar_bool_;
+  const char * scalar_string_;
+  Array<Termination,constants::JSON_TOKEN_MAX> terminations_;
+  char * request_;
+  char original_[constants::STRING_LENGTH_REQUEST];
+  int original_offset_;
+
+  char peek();
+  void skipWhitespace();
+  void skipSeparators();
+  bool isWhitespace(char c);
+  bool isDelimiter(char c,
+    bool key);
+  bool parseArray(ArduinoJson::JsonArray json_array,
+    size_t depth,
+    char close);
+  bool parseObject(ArduinoJson::JsonObject json_object,
+    size_t depth);
+  bool parseScalar(bool key);
+  bool parseQuotedString();
+  void classifyBareWord(const char * start,
+    const char * end);
+  bool matchesLiteral(const char * start,
+    size_t length,
+    const char * literal);
+  int hexValue(char c);
+  bool addScalar(ArduinoJson::JsonArray json_array);
+  bool addScalar(ArduinoJson::JsonObject json_object,
+    const char * key);
+  bool terminate(char * position);
+  void saveOriginal(char * position);
+  void restore();
+
+};
+}
+
+#endif
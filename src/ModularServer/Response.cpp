@@ -77,6 +77,30 @@ void Response::write(Vector<constants::SubsetMemberType> & value,
   }
 }
 
+void Response::write(double value)
+{
+  if (error_)
+  {
+    return;
+  }
+  writeDouble(value);
+}
+
+void Response::writeArray(double * value,
+  size_t N)
+{
+  if (error_)
+  {
+    return;
+  }
+  json_stream_ptr_->beginArray();
+  for (size_t i=0; i<N; ++i)
+  {
+    writeDouble(value[i]);
+  }
+  json_stream_ptr_->endArray();
+}
+
 void Response::writeNull()
 {
   if (error_)
@@ -138,7 +162,10 @@ long Response::pipeFrom(JsonStream & json_stream)
   {
     return 0;
   }
-  if (&(json_stream.getStream()) == &(json_stream_ptr_->getStream()))
+  // responses are written through a buffering stream, so also compare
+  // against the stream it wraps
+  if ((&(json_stream.getStream()) == &(json_stream_ptr_->getStream())) ||
+    (&(json_stream.getStream()) == server_stream_ptr_))
   {
     return -1;
   }
@@ -189,6 +216,7 @@ bool Response::error()
 Response::Response()
 {
   json_stream_ptr_ = NULL;
+  server_stream_ptr_ = NULL;
   reset();
 }
 
@@ -203,6 +231,11 @@ void Response::setJsonStream(JsonStream & json_stream)
   json_stream_ptr_ = &json_stream;
 }
 
+void Response::setServerStream(Stream & server_stream)
+{
+  server_stream_ptr_ = &server_stream;
+}
+
 void Response::begin()
 {
   reset();
@@ -218,6 +251,7 @@ void Response::end()
   error_ = false;
   endObject();
   json_stream_ptr_->writeNewline();
+  json_stream_ptr_->getStream().flush();
 }
 
 void Response::setCompactPrint()
@@ -230,6 +264,35 @@ void Response::setPrettyPrint()
   json_stream_ptr_->setPrettyPrint();
 }
 
+void Response::writeSerialized(const char * json,
+  size_t length)
+{
+  if (error_)
+  {
+    return;
+  }
+  // json already serialized as one complete value, copied out in bulk
+  json_stream_ptr_->getStream().write((const uint8_t *)json,length);
+}
+
+void Response::writeDouble(double value)
+{
+  if (!isfinite(value))
+  {
+    json_stream_ptr_->write(value);
+    return;
+  }
+  // shortest digits that read back as the same double
+  char value_str[constants::STRING_LENGTH_DOUBLE];
+  DoubleFormatter::toString(value,value_str);
+  json_stream_ptr_->writeJson(value_str);
+}
+
+void Response::setResultKeyInResponse(bool result_key_in_response)
+{
+  result_key_in_response_ = result_key_in_response;
+}
+
 void Response::returnRequestParseError(const char * const request)
 {
   // Prevent multiple errors in one response
@@ -262,13 +325,13 @@ void Response::returnParameterCountError(size_t parameter_count,
     strcat(error_str,incorrect_parameter_number_str);
     char parameter_count_str[constants::STRING_LENGTH_PARAMETER_COUNT];
     parameter_count_str[0] = '\0';
-    dtostrf(parameter_count,0,0,parameter_count_str);
+    ltoa(parameter_count,parameter_count_str,10);
     strcat(error_str,parameter_count_str);
     char given_str[constants::given_constant_string.length()+1];
     given_str[0] = '\0';
     constants::given_constant_string.copy(given_str);
     strcat(error_str,given_str);
-    dtostrf(parameter_count_needed,0,0,parameter_count_str);
+    ltoa(parameter_count_needed,parameter_count_str,10);
     strcat(error_str,parameter_count_str);
     char needed_str[constants::needed_constant_string.length()+1];
     needed_str[0] = '\0';
@@ -427,7 +490,8 @@ void Response::returnParameterNotInSubsetError(const char * const subset_str,
 void Response::returnParameterNotInRangeError(const ConstantString & parameter_name,
   const JsonStream::JsonTypes & parameter_type,
   const char * const min_str,
-  const char * const max_str)
+  const char * const max_str,
+  int element_index)
 {
   // Prevent multiple errors in one response
   if (!error_)
@@ -464,6 +528,14 @@ void Response::returnParameterNotInRangeError(const ConstantString & parameter_n
       element_str[0] = '\0';
       constants::element_constant_string.copy(element_str);
       strcat(error_str,element_str);
+      if (element_index >= 0)
+      {
+        // first element found out of range
+        char element_index_str[JsonStream::STRING_LENGTH_DOUBLE];
+        element_index_str[0] = ' ';
+        ltoa(element_index,element_index_str+1,10);
+        strcat(error_str,element_index_str);
+      }
     }
     strcat(error_str,less_than_equal_str);
     strcat(error_str,max_str);
@@ -505,13 +577,13 @@ void Response::returnPropertyParameterCountError(size_t parameter_count,
     strcat(error_str,incorrect_parameter_number_str);
     char parameter_count_str[constants::STRING_LENGTH_PARAMETER_COUNT];
     parameter_count_str[0] = '\0';
-    dtostrf(parameter_count,0,0,parameter_count_str);
+    ltoa(parameter_count,parameter_count_str,10);
     strcat(error_str,parameter_count_str);
     char given_str[constants::given_constant_string.length()+1];
     given_str[0] = '\0';
     constants::given_constant_string.copy(given_str);
     strcat(error_str,given_str);
-    dtostrf(parameter_count_needed,0,0,parameter_count_str);
+    ltoa(parameter_count_needed,parameter_count_str,10);
     strcat(error_str,parameter_count_str);
     char needed_str[constants::needed_constant_string.length()+1];
     needed_str[0] = '\0';
@@ -555,13 +627,13 @@ void Response::returnCallbackParameterCountError(size_t parameter_count,
     strcat(error_str,incorrect_parameter_number_str);
     char parameter_count_str[constants::STRING_LENGTH_PARAMETER_COUNT];
     parameter_count_str[0] = '\0';
-    dtostrf(parameter_count,0,0,parameter_count_str);
+    ltoa(parameter_count,parameter_count_str,10);
     strcat(error_str,parameter_count_str);
     char given_str[constants::given_constant_string.length()+1];
     given_str[0] = '\0';
     constants::given_constant_string.copy(given_str);
     strcat(error_str,given_str);
-    dtostrf(parameter_count_needed,0,0,parameter_count_str);
+    ltoa(parameter_count_needed,parameter_count_str,10);
     strcat(error_str,parameter_count_str);
     char needed_str[constants::needed_constant_string.length()+1];
     needed_str[0] = '\0';
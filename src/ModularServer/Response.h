@@ -12,6 +12,7 @@
 #include <JsonStream.h>
 
 #include "Constants.h"
+#include "DoubleFormatter.h"
 
 
 namespace modular_server
@@ -36,28 +37,44 @@ public:
   void writeKey(K key);
   template <typename T>
   void write(T value);
+  void write(double value);
   template <typename T,
     size_t N>
   void write(T (&value)[N]);
+  template <size_t N>
+  void write(double (&value)[N]);
   void write(Vector<constants::SubsetMemberType> & value,
     JsonStream::JsonTypes type);
   template <typename K,
     typename T>
   void write(K key,
     T value);
+  template <typename K>
+  void write(K key,
+    double value);
   template <typename K,
     typename T,
     size_t N>
   void write(K key,
     T (&value)[N]);
+  template <typename K,
+    size_t N>
+  void write(K key,
+    double (&value)[N]);
   template <typename T>
   void writeArray(T * value,
     size_t N);
+  void writeArray(double * value,
+    size_t N);
   template <typename K,
     typename T>
   void writeArray(K key,
     T * value,
     size_t N);
+  template <typename K>
+  void writeArray(K key,
+    double * value,
+    size_t N);
   void writeNull();
   template <typename K>
   void writeNull(K key);
@@ -74,16 +91,22 @@ public:
 
 private:
   JsonStream * json_stream_ptr_;
+  Stream * server_stream_ptr_;
   bool error_;
   bool result_key_in_response_;
 
   Response();
   void reset();
   void setJsonStream(JsonStream & json_stream);
+  void setServerStream(Stream & server_stream);
   void begin();
   void end();
   void setCompactPrint();
   void setPrettyPrint();
+  void writeSerialized(const char * json,
+    size_t length);
+  void writeDouble(double value);
+  void setResultKeyInResponse(bool result_key_in_response);
   void returnRequestParseError(const char * const request);
   void returnParameterCountError(size_t parameter_count,
     size_t parameter_count_needed);
@@ -99,7 +122,8 @@ private:
   void returnParameterNotInRangeError(const ConstantString & parameter_name,
     const JsonStream::JsonTypes & parameter_type,
     const char * const min_str,
-    const char * const max_str);
+    const char * const max_str,
+    int element_index=-1);
   void returnPropertyFunctionNotFoundError();
   void returnPropertyParameterCountError(size_t parameter_count,
     size_t parameter_count_needed);
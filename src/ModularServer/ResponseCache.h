@@ -0,0 +1,79 @@
+// ----------------------------------------------------------------------------
+// ResponseCache.h
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_RESPONSE_CACHE_H_
+#define _MODULAR_SERVER_RESPONSE_CACHE_H_
+#include <Arduino.h>
+#include <Array.h>
+
+
+namespace modular_server
+{
+// Write only stream holding compact json serializations. Each entry is
+// keyed by an owner pointer and a 32 bit key, plus optional key bytes
+// stored ahead of the serialization and compared on every find, and stays
+// valid until the cache is cleared. A serialization that does not fit, or that the caller
+// rejects, is remembered as failed so it is not captured again on every
+// request.
+template <size_t SIZE,
+  size_t ENTRY_COUNT_MAX>
+class ResponseCache : public Stream
+{
+public:
+  ResponseCache();
+
+  size_t write(uint8_t byte);
+  size_t write(const uint8_t * buffer,
+    size_t size);
+  using Print::write;
+  int available();
+  int read();
+  int peek();
+  void flush();
+
+  void enable();
+  void clear();
+  bool find(const void * key_ptr,
+    uint32_t key,
+    const char * & data,
+    size_t & length,
+    const char * key_data=NULL,
+    size_t key_length=0);
+  bool beginCapture(const void * key_ptr,
+    uint32_t key,
+    const char * key_data=NULL,
+    size_t key_length=0);
+  void endCapture(bool keep=true);
+
+private:
+  struct Entry
+  {
+    const void * key_ptr;
+    uint32_t key;
+    size_t key_offset;
+    size_t key_length;
+    size_t offset;
+    size_t length;
+    bool stored;
+  };
+  char buffer_[SIZE];
+  size_t size_;
+  Array<Entry,ENTRY_COUNT_MAX> entries_;
+  bool enabled_;
+  bool capturing_;
+  bool overflow_;
+
+  bool keyMatches(Entry & entry,
+    const void * key_ptr,
+    uint32_t key,
+    const char * key_data,
+    size_t key_length);
+};
+}
+#include "ResponseCacheDefinitions.h"
+
+#endif
@@ -0,0 +1,202 @@
+// ----------------------------------------------------------------------------
+// ResponseCacheDefinitions.h
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_RESPONSE_CACHE_DEFINITIONS_H_
+#define _MODULAR_SERVER_RESPONSE_CACHE_DEFINITIONS_H_
+
+
+namespace modular_server
+{
+// public
+template <size_t SIZE,
+  size_t ENTRY_COUNT_MAX>
+ResponseCache<SIZE,ENTRY_COUNT_MAX>::ResponseCache()
+{
+  enabled_ = false;
+  clear();
+}
+
+template <size_t SIZE,
+  size_t ENTRY_COUNT_MAX>
+size_t ResponseCache<SIZE,ENTRY_COUNT_MAX>::write(uint8_t byte)
+{
+  if (!capturing_ || overflow_ || (size_ >= SIZE))
+  {
+    overflow_ = true;
+    return 0;
+  }
+  buffer_[size_++] = byte;
+  return 1;
+}
+
+template <size_t SIZE,
+  size_t ENTRY_COUNT_MAX>
+size_t ResponseCache<SIZE,ENTRY_COUNT_MAX>::write(const uint8_t * buffer,
+  size_t size)
+{
+  if (!capturing_ || overflow_ || (size > (SIZE - size_)))
+  {
+    overflow_ = true;
+    return 0;
+  }
+  memcpy(buffer_ + size_,buffer,size);
+  size_ += size;
+  return size;
+}
+
+template <size_t SIZE,
+  size_t ENTRY_COUNT_MAX>
+int ResponseCache<SIZE,ENTRY_COUNT_MAX>::available()
+{
+  return 0;
+}
+
+template <size_t SIZE,
+  size_t ENTRY_COUNT_MAX>
+int ResponseCache<SIZE,ENTRY_COUNT_MAX>::read()
+{
+  return -1;
+}
+
+template <size_t SIZE,
+  size_t ENTRY_COUNT_MAX>
+int ResponseCache<SIZE,ENTRY_COUNT_MAX>::peek()
+{
+  return -1;
+}
+
+template <size_t SIZE,
+  size_t ENTRY_COUNT_MAX>
+void ResponseCache<SIZE,ENTRY_COUNT_MAX>::flush()
+{
+}
+
+template <size_t SIZE,
+  size_t ENTRY_COUNT_MAX>
+void ResponseCache<SIZE,ENTRY_COUNT_MAX>::enable()
+{
+  enabled_ = true;
+}
+
+template <size_t SIZE,
+  size_t ENTRY_COUNT_MAX>
+void ResponseCache<SIZE,ENTRY_COUNT_MAX>::clear()
+{
+  size_ = 0;
+  entries_.clear();
+  capturing_ = false;
+  overflow_ = false;
+}
+
+template <size_t SIZE,
+  size_t ENTRY_COUNT_MAX>
+bool ResponseCache<SIZE,ENTRY_COUNT_MAX>::find(const void * key_ptr,
+  uint32_t key,
+  const char * & data,
+  size_t & length,
+  const char * key_data,
+  size_t key_length)
+{
+  for (size_t i=0; i<entries_.size(); ++i)
+  {
+    Entry & entry = entries_[i];
+    if (entry.stored &&
+      keyMatches(entry,key_ptr,key,key_data,key_length))
+    {
+      data = buffer_ + entry.offset;
+      length = entry.length;
+      return true;
+    }
+  }
+  return false;
+}
+
+template <size_t SIZE,
+  size_t ENTRY_COUNT_MAX>
+bool ResponseCache<SIZE,ENTRY_COUNT_MAX>::beginCapture(const void * key_ptr,
+  uint32_t key,
+  const char * key_data,
+  size_t key_length)
+{
+  if (!enabled_ || capturing_ || entries_.full() || (key_length > (SIZE - size_)))
+  {
+    return false;
+  }
+  for (size_t i=0; i<entries_.size(); ++i)
+  {
+    if (keyMatches(entries_[i],key_ptr,key,key_data,key_length))
+    {
+      return false;
+    }
+  }
+  Entry entry;
+  entry.key_ptr = key_ptr;
+  entry.key = key;
+  entry.key_offset = size_;
+  entry.key_length = key_length;
+  if (key_length > 0)
+  {
+    memcpy(buffer_ + size_,key_data,key_length);
+    size_ += key_length;
+  }
+  entry.offset = size_;
+  entry.length = 0;
+  entry.stored = false;
+  entries_.push_back(entry);
+  capturing_ = true;
+  overflow_ = false;
+  return true;
+}
+
+template <size_t SIZE,
+  size_t ENTRY_COUNT_MAX>
+void ResponseCache<SIZE,ENTRY_COUNT_MAX>::endCapture(bool keep)
+{
+  if (!capturing_)
+  {
+    return;
+  }
+  Entry & entry = entries_.back();
+  if (overflow_ || !keep || (size_ == entry.offset))
+  {
+    // failed entries keep only the hash, so they also block requests
+    // that merely collide with them from being captured
+    size_ = entry.key_offset;
+    entry.key_length = 0;
+  }
+  else
+  {
+    entry.length = size_ - entry.offset;
+    entry.stored = true;
+  }
+  capturing_ = false;
+  overflow_ = false;
+}
+
+// private
+template <size_t SIZE,
+  size_t ENTRY_COUNT_MAX>
+bool ResponseCache<SIZE,ENTRY_COUNT_MAX>::keyMatches(Entry & entry,
+  const void * key_ptr,
+  uint32_t key,
+  const char * key_data,
+  size_t key_length)
+{
+  if ((entry.key_ptr != key_ptr) || (entry.key != key))
+  {
+    return false;
+  }
+  if (!entry.stored)
+  {
+    return true;
+  }
+  return ((entry.key_length == key_length) &&
+    ((key_length == 0) || (memcmp(buffer_ + entry.key_offset,key_data,key_length) == 0)));
+}
+
+}
+#endif
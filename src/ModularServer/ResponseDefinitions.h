@@ -19,7 +19,7 @@ void Response::returnResult(T value)
   if (!result_key_in_response_ && !error_)
   {
     result_key_in_response_ = true;
-    json_stream_ptr_->write(constants::result_constant_string,value);
+    write(constants::result_constant_string,value);
   }
 }
 
@@ -31,7 +31,7 @@ void Response::returnResult(T (&value)[N])
   if (!result_key_in_response_ && !error_)
   {
     result_key_in_response_ = true;
-    json_stream_ptr_->write(constants::result_constant_string,value);
+    write(constants::result_constant_string,value);
   }
 }
 
@@ -43,7 +43,7 @@ void Response::returnResult(T * value,
   if (!result_key_in_response_ && !error_)
   {
     result_key_in_response_ = true;
-    json_stream_ptr_->writeArray(constants::result_constant_string,value,N);
+    writeArray(constants::result_constant_string,value,N);
   }
 }
 
@@ -106,6 +106,24 @@ void Response::write(K key,
   json_stream_ptr_->write(key,value);
 }
 
+template <size_t N>
+void Response::write(double (&value)[N])
+{
+  writeArray(value,N);
+}
+
+template <typename K>
+void Response::write(K key,
+  double value)
+{
+  if (error_)
+  {
+    return;
+  }
+  json_stream_ptr_->writeKey(key);
+  writeDouble(value);
+}
+
 template <typename K,
   typename T,
   size_t N>
@@ -130,6 +148,14 @@ void Response::writeArray(T * value,
   json_stream_ptr_->writeArray(value,N);
 }
 
+template <typename K,
+  size_t N>
+void Response::write(K key,
+  double (&value)[N])
+{
+  writeArray(key,value,N);
+}
+
 template <typename K,
   typename T>
 void Response::writeArray(K key,
@@ -143,6 +169,19 @@ void Response::writeArray(K key,
   json_stream_ptr_->writeArray(key,value,N);
 }
 
+template <typename K>
+void Response::writeArray(K key,
+  double * value,
+  size_t N)
+{
+  if (error_)
+  {
+    return;
+  }
+  json_stream_ptr_->writeKey(key);
+  writeArray(value,N);
+}
+
 template <typename K>
 void Response::writeNull(K key)
 {
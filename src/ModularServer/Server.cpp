@@ -6,6 +6,7 @@
 // Peter Polidoro peter@polidoro.io
 // ----------------------------------------------------------------------------
 #include "Server.h"
+#include "ElementTables.h"
 
 
 namespace modular_server
@@ -21,9 +22,15 @@ void Server::setup()
   request_method_index_ = -1;
   property_function_index_ = -1;
   callback_function_index_ = -1;
+  method_index_count_ = 0;
+  method_index_complete_ = false;
+  stable_method_ids_enabled_ = false;
   server_stream_index_ = 0;
+  server_stream_credit_ = 0;
+  requests_per_call_max_ = constants::requests_per_call_max_default;
 
   eeprom_initialized_ = false;
+  api_hashes_valid_ = false;
 
   constants::SubsetMemberType all;
   all.cs_ptr = &constants::all_constant_string;
@@ -46,11 +53,13 @@ void Server::setup()
     server_properties_,
     server_parameters_,
     server_functions_,
-    server_callbacks_);
+    server_callbacks_,
+    constants::element_tables);
 
   // Properties
   Property::response_ptr_ = &response_;
-  Property::get_parameter_value_functor_ = makeFunctor((Functor1wRet<const ConstantString &,ArduinoJson::JsonVariant> *)0,*this,&Server::getParameterValue);
+  Property::default_value_changed_functor_ = makeFunctor((Functor0 *)0,*this,&Server::resultsChanged);
+  Property::value_changed_functor_ = makeFunctor((Functor1<Property &> *)0,*this,&Server::propertyValueChanged);
 
   Property & serial_number_property = createProperty(constants::serial_number_property_name,constants::serial_number_default);
   serial_number_property.setRange(constants::serial_number_min,constants::serial_number_max);
@@ -74,6 +83,7 @@ void Server::setup()
   pin_name_parameter.setSubset(pin_name_array_.data(),
     pin_name_array_.max_size(),
     pin_name_array_.size());
+  pin_name_parameter.setSubsetIndex(pin_name_subset_index_);
 
   Parameter & pin_mode_parameter = createParameter(constants::pin_mode_constant_string);
   pin_mode_parameter.setTypeString();
@@ -82,6 +92,15 @@ void Server::setup()
   Parameter & pin_value_parameter = createParameter(constants::pin_value_parameter_name);
   pin_value_parameter.setRange(constants::pin_value_min,constants::pin_value_max);
 
+  Parameter & api_hash_parameter = createParameter(constants::api_hash_parameter_name);
+  api_hash_parameter.setTypeString();
+
+  Parameter & cursor_parameter = createParameter(constants::cursor_parameter_name);
+  cursor_parameter.setRange(constants::cursor_min,constants::cursor_max);
+
+  Parameter & page_size_parameter = createParameter(constants::page_size_parameter_name);
+  page_size_parameter.setRange(constants::page_size_min,constants::page_size_max);
+
   // Functions
   Function & get_method_ids_function = createFunction(constants::get_method_ids_function_name);
   get_method_ids_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getMethodIdsHandler));
@@ -101,10 +120,12 @@ void Server::setup()
   Function & get_device_id_function = createFunction(constants::get_device_id_function_name);
   get_device_id_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getDeviceIdHandler));
   get_device_id_function.setResultTypeObject();
+  get_device_id_function.setResultCacheable();
 
   Function & get_device_info_function = createFunction(constants::get_device_info_function_name);
   get_device_info_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getDeviceInfoHandler));
   get_device_info_function.setResultTypeObject();
+  get_device_info_function.setResultCacheable();
 
   Function & get_api_function = createFunction(constants::get_api_function_name);
   get_api_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getApiHandler));
@@ -112,10 +133,32 @@ void Server::setup()
   get_api_function.addParameter(firmware_parameter);
   get_api_function.setResultTypeObject();
 
+  Function & get_api_hash_function = createFunction(constants::get_api_hash_function_name);
+  get_api_hash_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getApiHashHandler));
+  get_api_hash_function.addParameter(verbosity_parameter);
+  get_api_hash_function.addParameter(firmware_parameter);
+  get_api_hash_function.setResultTypeString();
+
+  Function & get_api_if_changed_function = createFunction(constants::get_api_if_changed_function_name);
+  get_api_if_changed_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getApiIfChangedHandler));
+  get_api_if_changed_function.addParameter(verbosity_parameter);
+  get_api_if_changed_function.addParameter(firmware_parameter);
+  get_api_if_changed_function.addParameter(api_hash_parameter);
+  get_api_if_changed_function.setResultTypeObject();
+
+  Function & get_api_page_function = createFunction(constants::get_api_page_function_name);
+  get_api_page_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getApiPageHandler));
+  get_api_page_function.addParameter(verbosity_parameter);
+  get_api_page_function.addParameter(firmware_parameter);
+  get_api_page_function.addParameter(cursor_parameter);
+  get_api_page_function.addParameter(page_size_parameter);
+  get_api_page_function.setResultTypeObject();
+
   Function & get_property_default_values_function = createFunction(constants::get_property_default_values_function_name);
   get_property_default_values_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getPropertyDefaultValuesHandler));
   get_property_default_values_function.addParameter(firmware_parameter);
   get_property_default_values_function.setResultTypeObject();
+  get_property_default_values_function.setResultCacheable();
 
   Function & set_properties_to_defaults_function = createFunction(constants::set_properties_to_defaults_function_name);
   set_properties_to_defaults_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::setPropertiesToDefaultsHandler));
@@ -126,6 +169,13 @@ void Server::setup()
   get_property_values_function.addParameter(firmware_parameter);
   get_property_values_function.setResultTypeObject();
 
+  Function & get_property_values_page_function = createFunction(constants::get_property_values_page_function_name);
+  get_property_values_page_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getPropertyValuesPageHandler));
+  get_property_values_page_function.addParameter(firmware_parameter);
+  get_property_values_page_function.addParameter(cursor_parameter);
+  get_property_values_page_function.addParameter(page_size_parameter);
+  get_property_values_page_function.setResultTypeObject();
+
   Function & get_pin_info_function = createFunction(constants::get_pin_info_function_name);
   get_pin_info_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getPinInfoHandler));
   get_pin_info_function.addParameter(pin_name_parameter);
@@ -154,30 +204,56 @@ void Server::setup()
   get_memory_free_function.setResultTypeLong();
 #endif
 
+  // appended after the other functions so no earlier method id moves
+  Function & get_function_ids_function = createFunction(constants::get_function_ids_function_name);
+  get_function_ids_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getFunctionIdsHandler));
+  get_function_ids_function.setResultTypeObject();
+
   // Callbacks
   Callback::pin_name_array_ptr_ = &pin_name_array_;
+  Callback::pin_name_subset_index_ptr_ = &pin_name_subset_index_;
   Callback::find_pin_ptr_by_chars_functor_ = makeFunctor((Functor1wRet<const char *,Pin *> *)0,*this,&Server::findPinPtrByChars);
   Callback::find_pin_ptr_by_constant_string_functor_ = makeFunctor((Functor1wRet<const ConstantString &,Pin *> *)0,*this,&Server::findPinPtrByConstantString);
-  Callback::get_parameter_value_functor_ = makeFunctor((Functor1wRet<const ConstantString &,ArduinoJson::JsonVariant> *)0,*this,&Server::getParameterValue);
 
   // Server
   server_running_ = false;
 }
 
 // Streams
-void Server::addServerStream(Stream & stream)
+ServerStream & Server::addServerStream(Stream & stream)
+{
+  for (size_t i=0;i<server_streams_.size();++i)
+  {
+    if (&(server_streams_[i].getStream()) == &stream)
+    {
+      return server_streams_[i];
+    }
+  }
+  if (server_streams_.size() < server_streams_.max_size())
+  {
+    server_streams_.push_back(ServerStream(stream));
+    return server_streams_.back();
+  }
+  return dummy_server_stream_;
+}
+
+ServerStream & Server::serverStream(Stream & stream)
 {
-  bool stream_found = false;
-  for (size_t i=0;i<server_stream_ptrs_.size();++i)
+  for (size_t i=0;i<server_streams_.size();++i)
   {
-    if (server_stream_ptrs_[i] == &stream)
+    if (&(server_streams_[i].getStream()) == &stream)
     {
-      stream_found = true;
+      return server_streams_[i];
     }
   }
-  if (!stream_found)
+  return dummy_server_stream_;
+}
+
+void Server::setRequestsPerCallMax(size_t requests_per_call_max)
+{
+  if (requests_per_call_max > 0)
   {
-    server_stream_ptrs_.push_back(&stream);
+    requests_per_call_max_ = requests_per_call_max;
   }
 }
 
@@ -185,11 +261,13 @@ void Server::addServerStream(Stream & stream)
 void Server::setDeviceName(const ConstantString & device_name)
 {
   device_name_ptr_ = &device_name;
+  resultsChanged();
 }
 
 void Server::setFormFactor(const ConstantString & form_factor)
 {
   form_factor_ptr_ = &form_factor;
+  resultsChanged();
 }
 
 // Hardware
@@ -215,7 +293,10 @@ void Server::removeHardware()
     }
 
     pins_.removeArray();
+    pin_ptrs_.clear();
+    pin_name_index_.clear();
     hardware_info_array_.pop_back();
+    apiChanged();
   }
 }
 
@@ -236,6 +317,7 @@ Pin & Server::createPin(const ConstantString & pin_name,
     pins_.push_back(Pin(pin_name,pin_number));
     const ConstantString * hardware_name_ptr = hardware_info_array_.back()->name_ptr;
     pins_.back().setHardwareName(*hardware_name_ptr);
+    apiChanged();
     return pins_.back();
   }
   return dummy_pin_;
@@ -246,7 +328,7 @@ Pin & Server::pin(const ConstantString & pin_name)
   int pin_index = findPinIndex(pin_name);
   if ((pin_index >= 0) && (pin_index < (int)pins_.size()))
   {
-    return pins_[pin_index];
+    return pinAt(pin_index);
   }
   return dummy_pin_;
 }
@@ -256,7 +338,7 @@ Pin * Server::findPinPtrByChars(const char * pin_name)
   int pin_index = findPinIndex(pin_name);
   if ((pin_index >= 0) && (pin_index < (int)pins_.size()))
   {
-    return &pins_[pin_index];
+    return &pinAt(pin_index);
   }
   return NULL;
 }
@@ -266,7 +348,7 @@ Pin * Server::findPinPtrByConstantString(const ConstantString & pin_name)
   int pin_index = findPinIndex(pin_name);
   if ((pin_index >= 0) && (pin_index < (int)pins_.size()))
   {
-    return &pins_[pin_index];
+    return &pinAt(pin_index);
   }
   return NULL;
 }
@@ -278,7 +360,7 @@ void Server::setPinMode(const ConstantString & pin_name,
   {
     for (size_t pin_index=0; pin_index<pins_.size(); ++pin_index)
     {
-      Pin & pin = pins_[pin_index];
+      Pin & pin = pinAt(pin_index);
       pin.setMode(pin_mode);
     }
     return;
@@ -327,7 +409,7 @@ Property & Server::property(const ConstantString & property_name)
   int property_index = findPropertyIndex(property_name);
   if ((property_index >= 0) && (property_index < (int)properties_.size()))
   {
-    return properties_[property_index];
+    return propertyAt(property_index);
   }
   return dummy_property_;
 }
@@ -341,6 +423,7 @@ Parameter & Server::createParameter(const ConstantString & parameter_name)
     parameters_.push_back(Parameter(parameter_name));
     const ConstantString * firmware_name_ptr = firmware_info_array_.back()->name_ptr;
     parameters_.back().setFirmwareName(*firmware_name_ptr);
+    parameters_.back().setFirmwareIndex(firmware_info_array_.size() - 1);
     return parameters_.back();
   }
   return dummy_parameter_;
@@ -351,7 +434,7 @@ Parameter & Server::parameter(const ConstantString & parameter_name)
   int parameter_index = findParameterIndex(parameter_name);
   if ((parameter_index >= 0) && (parameter_index < (int)parameters_.size()))
   {
-    return parameters_[parameter_index];
+    return parameterAt(parameter_index);
   }
   return dummy_parameter_;
 }
@@ -373,6 +456,7 @@ Function & Server::createFunction(const ConstantString & function_name)
     functions_.push_back(Function(function_name));
     const ConstantString * firmware_name_ptr = firmware_info_array_.back()->name_ptr;
     functions_.back().setFirmwareName(*firmware_name_ptr);
+    functions_.back().setFirmwareIndex(firmware_info_array_.size() - 1);
     return functions_.back();
   }
   return dummy_function_;
@@ -383,7 +467,7 @@ Function & Server::function(const ConstantString & function_name)
   int function_index = findFunctionIndex(function_name);
   if ((function_index >= 0) && (function_index < (int)functions_.size()))
   {
-    return functions_[function_index];
+    return functionAt(function_index);
   }
   return dummy_function_;
 }
@@ -405,6 +489,7 @@ Callback & Server::createCallback(const ConstantString & callback_name)
     callbacks_.push_back(Callback(callback_name));
     const ConstantString * firmware_name_ptr = firmware_info_array_.back()->name_ptr;
     callbacks_.back().setFirmwareName(*firmware_name_ptr);
+    callbacks_.back().setFirmwareIndex(firmware_info_array_.size() - 1);
     return callbacks_.back();
   }
   return dummy_callback_;
@@ -415,7 +500,7 @@ Callback & Server::callback(const ConstantString & callback_name)
   int callback_index = findCallbackIndex(callback_name);
   if ((callback_index >= 0) && (callback_index < (int)callbacks_.size()))
   {
-    return callbacks_[callback_index];
+    return callbackAt(callback_index);
   }
   return dummy_callback_;
 }
@@ -437,6 +522,21 @@ void Server::startServer()
   // Pin Pulse Event Controller
   Pin::setupPinPulseEventController();
 
+  updateElementIndexes();
+  buildMethodIndex();
+
+  // the api only changes while firmware and hardware are being set up
+  apiChanged();
+  api_cache_.enable();
+  result_cache_.enable();
+  updateApiHashes();
+
+  // parameter types may change after they are added to a function
+  for (size_t i=0; i<functions_.size(); ++i)
+  {
+    functionAt(i).checkTypedFunctor();
+  }
+
   server_running_ = true;
 }
 
@@ -445,54 +545,60 @@ void Server::stopServer()
   server_running_ = false;
 }
 
+void Server::enableStableMethodIds()
+{
+  stable_method_ids_enabled_ = true;
+}
+
+void Server::disableStableMethodIds()
+{
+  stable_method_ids_enabled_ = false;
+}
+
 void Server::handleRequest()
 {
-  if (server_running_ && (server_stream_ptrs_.size() > 0) && (server_json_stream_.available() > 0))
+  if (!server_running_ || (server_streams_.size() == 0))
   {
-    char request[constants::STRING_LENGTH_REQUEST];
-    long bytes_read = server_json_stream_.readJsonIntoBuffer(request);
-    if (bytes_read > 0)
+    return;
+  }
+  // drain queued response output as far as each stream has room
+  for (size_t i=0; i<server_streams_.size(); ++i)
+  {
+    server_streams_[i].transmit();
+  }
+  // Weighted round robin over ready streams: each stream may be served up
+  // to its weight in requests before its turn passes to the next stream
+  size_t requests_served = 0;
+  size_t idle_stream_count = 0;
+  while (requests_served < requests_per_call_max_)
+  {
+    if (server_stream_credit_ == 0)
     {
-      JsonSanitizer<constants::JSON_TOKEN_MAX> sanitizer;
-      if (sanitizer.firstCharIsValidJson(request))
-      {
-        response_.setCompactPrint();
-      }
-      else
-      {
-        response_.setPrettyPrint();
-      }
-      response_.begin();
-      sanitizer.sanitizeBuffer(request);
-      StaticJsonDocument<constants::JSON_DOCUMENT_SIZE> json_document;
-      if (sanitizer.firstCharIsValidJsonObject(request))
-      {
-        response_.returnError(constants::object_request_error_data);
-      }
-      else
-      {
-        ArduinoJson::DeserializationError error = deserializeJson(json_document,request);
-        if (!error)
-        {
-          request_json_array_ = json_document.as<ArduinoJson::JsonArray>();
-          processRequestArray();
-        }
-        else
-        {
-          response_.returnRequestParseError(request);
-        }
-      }
-      response_.end();
+      incrementServerStream();
+      continue;
     }
-    else if (bytes_read < 0)
+    ServerStream & server_stream = server_streams_[server_stream_index_];
+    // a stream still draining a previous response is treated as idle
+    if (server_stream.outputReady() && server_stream.readAvailable())
     {
-      response_.setCompactPrint();
-      response_.begin();
-      response_.returnError(constants::request_length_error_data);
-      response_.end();
+      server_json_stream_.setStream(server_stream);
+      response_.setServerStream(server_stream.getStream());
+      processRequest(server_stream);
+      server_stream.clearRequest();
+      ++server_stream.served_request_count_;
+      --server_stream_credit_;
+      ++requests_served;
+      idle_stream_count = 0;
+    }
+    else
+    {
+      if (++idle_stream_count >= server_streams_.size())
+      {
+        break;
+      }
+      incrementServerStream();
     }
   }
-  incrementServerStream();
 }
 
 // private
@@ -503,7 +609,7 @@ ArduinoJson::JsonVariant Server::getParameterValue(const ConstantString & parame
   if (request_method_index_ < (int)functions_.size())
   {
     int function_index = request_method_index_;
-    Function & function = functions_[function_index];
+    Function & function = functionAt(function_index);
     parameter_index += findFunctionParameterIndex(function,parameter_name);
   }
   else if (request_method_index_ < (int)(functions_.size() + callbacks_.size()))
@@ -511,7 +617,7 @@ ArduinoJson::JsonVariant Server::getParameterValue(const ConstantString & parame
     if (callback_function_index_ >= 0)
     {
       int callback_index = request_method_index_ - functions_.size();
-      Callback & callback = callbacks_[callback_index];
+      Callback & callback = callbackAt(callback_index);
       Function & function = callback.functions_[callback_function_index_];
 
       // index 0 is the request method, index 1 is the callback function
@@ -523,7 +629,7 @@ ArduinoJson::JsonVariant Server::getParameterValue(const ConstantString & parame
     if (property_function_index_ >= 0)
     {
       int property_index = request_method_index_ - functions_.size() - callbacks_.size();
-      Property & property = properties_[property_index];
+      Property & property = propertyAt(property_index);
       Function & function = property.functions_[property_function_index_];
 
       // index 0 is the request method, index 1 is the property function
@@ -572,7 +678,7 @@ void Server::processRequestArray()
     if (request_method_index_ < (int)functions_.size())
     {
       int function_index = request_method_index_;
-      Function & function = functions_[function_index];
+      Function & function = functionAt(function_index);
       // function ?
       if ((parameter_count == 1) && (strcmp(parameter0_string,question_str) == 0))
       {
@@ -591,7 +697,7 @@ void Server::processRequestArray()
         ((strcmp(parameter1_string,question_str) == 0) ||
           (strcmp(parameter1_string,question_double_str) == 0)))
       {
-        int parameter_index = processParameterString(function,parameter0_string);
+        int parameter_index = processParameterElement(function,1);
         if (parameter_index >= 0)
         {
           Parameter & parameter = *(function.parameter_ptrs_[parameter_index]);
@@ -615,16 +721,17 @@ void Server::processRequestArray()
       {
         size_t request_array_start_index = 1; // skip none
         bool parameters_ok = checkParameters(function,request_array_start_index);
-        if (parameters_ok)
+        if (parameters_ok && !callFunction(function))
         {
-          function.functor();
+          response_.returnError(constants::function_handler_parameters_error_data);
         }
+        clearArguments(function);
       }
     }
     else if (request_method_index_ < (int)(functions_.size() + callbacks_.size()))
     {
       int callback_index = request_method_index_ - functions_.size();
-      Callback & callback = callbacks_[callback_index];
+      Callback & callback = callbackAt(callback_index);
       // callback ?
       if ((parameter_count == 1) && (strcmp(parameter0_string,question_str) == 0))
       {
@@ -642,7 +749,7 @@ void Server::processRequestArray()
       {
         // shortcut for callback call function
         callback.updateFunctionsAndParameters();
-        Function & function = callback.function(callback::trigger_function_name);
+        Function & function = callback.functions_[callback::TRIGGER_FUNCTION_ID];
         function.functor();
         return;
       }
@@ -651,9 +758,8 @@ void Server::processRequestArray()
       {
         callback.updateFunctionsAndParameters();
 
-        // index 0 is the request method, index 1 is the callback function
-        const char * callback_function_name = parameter0_string;
-        callback_function_index_ = callback.findFunctionIndex(callback_function_name);
+        // index 0 is the request method, index 1 is the callback function name or id
+        callback_function_index_ = findMethodFunctionIndex(callback,1);
         if (callback_function_index_ < 0)
         {
           response_.returnCallbackFunctionNotFoundError();
@@ -682,7 +788,7 @@ void Server::processRequestArray()
           ((strcmp(parameter2_string,question_str) == 0) ||
             (strcmp(parameter2_string,question_double_str) == 0)))
         {
-          int parameter_index = processParameterString(function,parameter1_string);
+          int parameter_index = processParameterElement(function,2);
           if (parameter_index >= 0)
           {
             Parameter & parameter = *(function.parameter_ptrs_[parameter_index]);
@@ -705,13 +811,14 @@ void Server::processRequestArray()
           {
             function.functor();
           }
+          clearArguments(function);
         }
       }
     }
     else if (request_method_index_ < (int)(functions_.size() + callbacks_.size() + properties_.size()))
     {
       int property_index = request_method_index_ - functions_.size() - callbacks_.size();
-      Property & property = properties_[property_index];
+      Property & property = propertyAt(property_index);
       // property ?
       if ((parameter_count == 1) && (strcmp(parameter0_string,question_str) == 0))
       {
@@ -729,7 +836,7 @@ void Server::processRequestArray()
       {
         // shortcut for property getValue function
         property.updateFunctionsAndParameters();
-        Function & function = property.function(property::get_value_function_name);
+        Function & function = property.functions_[property::GET_VALUE_FUNCTION_ID];
         function.functor();
         return;
       }
@@ -738,9 +845,8 @@ void Server::processRequestArray()
       {
         property.updateFunctionsAndParameters();
 
-        // index 0 is the request method, index 1 is the property function
-        const char * property_function_name = parameter0_string;
-        property_function_index_ = property.findFunctionIndex(property_function_name);
+        // index 0 is the request method, index 1 is the property function name or id
+        property_function_index_ = findMethodFunctionIndex(property,1);
         if (property_function_index_ < 0)
         {
           response_.returnPropertyFunctionNotFoundError();
@@ -769,7 +875,7 @@ void Server::processRequestArray()
           ((strcmp(parameter2_string,question_str) == 0) ||
             (strcmp(parameter2_string,question_double_str) == 0)))
         {
-          int parameter_index = processParameterString(function,parameter1_string);
+          int parameter_index = processParameterElement(function,2);
           if (parameter_index >= 0)
           {
             Parameter & parameter = *(function.parameter_ptrs_[parameter_index]);
@@ -792,6 +898,7 @@ void Server::processRequestArray()
           {
             function.functor();
           }
+          clearArguments(function);
         }
       }
     }
@@ -803,27 +910,81 @@ void Server::processRequestArray()
   }
 }
 
-int Server::findMethodIndex(const char * method_string)
+void Server::addElementTables(const constants::ElementTables & element_tables)
 {
-  int method_index = findFunctionIndex(method_string);
-  if (method_index >= 0)
+  // a table that does not fit or is out of order is left out, its elements
+  // are then indexed like those of firmware added without tables
+  property_table_index_.addTable(element_tables.property_name_hashes,element_tables.property_count);
+  parameter_table_index_.addTable(element_tables.parameter_name_hashes,element_tables.parameter_count);
+  function_table_index_.addTable(element_tables.function_name_hashes,element_tables.function_count);
+  callback_table_index_.addTable(element_tables.callback_name_hashes,element_tables.callback_count);
+}
+
+void Server::updateElementIndexes()
+{
+  updateElementIndex(pin_ptrs_,pins_,pin_name_index_);
+  updateElementIndex(property_ptrs_,properties_,property_table_index_,property_name_index_);
+  updateElementIndex(parameter_ptrs_,parameters_,parameter_table_index_,parameter_name_index_);
+  updateElementIndex(function_ptrs_,functions_,function_table_index_,function_name_index_);
+  updateElementIndex(callback_ptrs_,callbacks_,callback_table_index_,callback_name_index_);
+}
+
+Pin & Server::pinAt(size_t pin_index)
+{
+  if (pin_index < pin_ptrs_.size())
   {
-    response_.write(constants::id_constant_string,method_string);
-    return method_index;
+    return *pin_ptrs_[pin_index];
   }
-  method_index = findCallbackIndex(method_string);
-  if (method_index >= 0)
+  return pins_[pin_index];
+}
+
+const ConstantString & Server::getElementName(Property & property)
+{
+  return property.parameter().getName();
+}
+
+Property & Server::propertyAt(size_t property_index)
+{
+  if (property_index < property_ptrs_.size())
   {
-    response_.write(constants::id_constant_string,method_string);
-    method_index += functions_.size();
-    return method_index;
+    return *property_ptrs_[property_index];
+  }
+  return properties_[property_index];
+}
+
+Parameter & Server::parameterAt(size_t parameter_index)
+{
+  if (parameter_index < parameter_ptrs_.size())
+  {
+    return *parameter_ptrs_[parameter_index];
+  }
+  return parameters_[parameter_index];
+}
+
+Function & Server::functionAt(size_t function_index)
+{
+  if (function_index < function_ptrs_.size())
+  {
+    return *function_ptrs_[function_index];
   }
-  method_index = findPropertyIndex(method_string);
+  return functions_[function_index];
+}
+
+Callback & Server::callbackAt(size_t callback_index)
+{
+  if (callback_index < callback_ptrs_.size())
+  {
+    return *callback_ptrs_[callback_index];
+  }
+  return callbacks_[callback_index];
+}
+
+int Server::findMethodIndex(const char * method_string)
+{
+  int method_index = lookupMethodIndex(method_string);
   if (method_index >= 0)
   {
     response_.write(constants::id_constant_string,method_string);
-    method_index += functions_.size() + callbacks_.size();
-    return method_index;
   }
   return method_index;
 }
@@ -831,14 +992,181 @@ int Server::findMethodIndex(const char * method_string)
 int Server::findMethodIndex(int method_id)
 {
   int method_index = -1;
-  if (method_id >= 0)
+  if (stableMethodIds())
+  {
+    if ((method_id >= 0) && (method_id <= UINT16_MAX))
+    {
+      method_index = findMethodIndexByStableId(method_id);
+    }
+  }
+  else if (method_id >= 0)
   {
     method_index = method_id;
+  }
+  if (method_index >= 0)
+  {
     response_.write(constants::id_constant_string,method_id);
   }
   return method_index;
 }
 
+int Server::lookupMethodIndex(const char * method_name)
+{
+  // the function, callback and property name indexes already make each of
+  // these constant time, in the same order the linear search used
+  int method_index = findFunctionIndex(method_name);
+  if (method_index >= 0)
+  {
+    return method_index;
+  }
+  method_index = findCallbackIndex(method_name);
+  if (method_index >= 0)
+  {
+    return method_index + functions_.size();
+  }
+  method_index = findPropertyIndex(method_name);
+  if (method_index >= 0)
+  {
+    return method_index + functions_.size() + callbacks_.size();
+  }
+  return -1;
+}
+
+size_t Server::getMethodCount()
+{
+  return functions_.size() + callbacks_.size() + properties_.size();
+}
+
+const ConstantString & Server::getMethodName(size_t method_index)
+{
+  if (method_index < functions_.size())
+  {
+    return functionAt(method_index).getName();
+  }
+  method_index -= functions_.size();
+  if (method_index < callbacks_.size())
+  {
+    return callbackAt(method_index).getName();
+  }
+  method_index -= callbacks_.size();
+  return propertyAt(method_index).getName();
+}
+
+bool Server::compareMethodName(size_t method_index,
+  const char * method_name)
+{
+  if (method_index < functions_.size())
+  {
+    return functionAt(method_index).compareName(method_name);
+  }
+  method_index -= functions_.size();
+  if (method_index < callbacks_.size())
+  {
+    return callbackAt(method_index).compareName(method_name);
+  }
+  method_index -= callbacks_.size();
+  return propertyAt(method_index).compareName(method_name);
+}
+
+void Server::updateMethodIndex()
+{
+  if (getMethodCount() != method_index_count_)
+  {
+    // methods were added after the index was built
+    buildMethodIndex();
+  }
+}
+
+void Server::buildMethodIndex()
+{
+  // methods are inserted in lookup order, so when names are duplicated the
+  // first one found is the same one the name lookup finds
+  method_id_index_.clear();
+  method_index_count_ = getMethodCount();
+  method_index_complete_ = false;
+  if (method_index_count_ > constants::METHOD_COUNT_MAX)
+  {
+    // too many methods, fall back to positional ids
+    return;
+  }
+  for (size_t method_index=0; method_index<method_index_count_; ++method_index)
+  {
+    uint32_t hash = NamedElement::hashName(getMethodName(method_index));
+
+    // stable id is the folded name hash. Distinct names sharing an id give
+    // the id to neither, so a cached id never reaches another method, and
+    // only the first of duplicated names gets one, as with name lookup
+    uint16_t method_id = (hash >> 16) ^ (hash & 0xFFFF);
+    method_ids_[method_index] = method_id;
+    method_id_valid_[method_index] = true;
+    int owner_index = findStableIdOwner(method_id);
+    if (owner_index < 0)
+    {
+      if (!method_id_index_.insert(method_id * constants::method_id_hash_multiplier,method_index))
+      {
+        // table too small, fall back to positional ids
+        return;
+      }
+    }
+    else
+    {
+      method_id_valid_[method_index] = false;
+      const ConstantString & method_name = getMethodName(method_index);
+      char method_name_str[method_name.length()+1];
+      method_name_str[0] = '\0';
+      method_name.copy(method_name_str);
+      if (!compareMethodName(owner_index,method_name_str))
+      {
+        method_id_valid_[owner_index] = false;
+      }
+    }
+  }
+  method_index_complete_ = true;
+}
+
+bool Server::stableMethodIds()
+{
+  updateMethodIndex();
+  return stable_method_ids_enabled_ && method_index_complete_;
+}
+
+int Server::getMethodId(size_t method_index)
+{
+  if (stableMethodIds())
+  {
+    if (!method_id_valid_[method_index])
+    {
+      return -1;
+    }
+    return method_ids_[method_index];
+  }
+  return method_index;
+}
+
+int Server::findMethodIndexByStableId(uint16_t method_id)
+{
+  int method_index = findStableIdOwner(method_id);
+  if ((method_index >= 0) && method_id_valid_[method_index])
+  {
+    return method_index;
+  }
+  return -1;
+}
+
+int Server::findStableIdOwner(uint16_t method_id)
+{
+  size_t probe = 0;
+  int method_index;
+  while ((method_index = method_id_index_.find(method_id * constants::method_id_hash_multiplier,probe)) >= 0)
+  {
+    if (method_ids_[method_index] == method_id)
+    {
+      return method_index;
+    }
+  }
+  return -1;
+}
+
 int Server::processParameterString(Function & function,
   const char * parameter_string)
 {
@@ -868,6 +1196,71 @@ int Server::processParameterString(Function & function,
   return parameter_index;
 }
 
+int Server::processParameterElement(Function & function,
+  size_t element_index)
+{
+  // an integer addresses the parameter by its position in the function
+  ArduinoJson::JsonVariant element = request_json_array_[element_index];
+  if (element.is<long>())
+  {
+    long parameter_id = element.as<long>();
+    if ((parameter_id < 0) || (parameter_id >= (long)function.parameter_ptrs_.size()))
+    {
+      response_.returnParameterNotFoundError();
+      return -1;
+    }
+    return parameter_id;
+  }
+  const char * parameter_string = getRequestElementAsString(element_index,request_json_array_.size());
+  return processParameterString(function,parameter_string);
+}
+
+bool Server::callFunction(Function & function)
+{
+  if (!function.resultCacheable() || !request_parser_.compact())
+  {
+    return function.functor();
+  }
+
+  // the whole request is the key, so results differ per argument list,
+  // and it is compared in full so hash collisions never replay a result
+  char request_key[constants::STRING_LENGTH_REQUEST];
+  size_t request_key_length = ArduinoJson::serializeJson(request_json_array_,request_key,sizeof(request_key));
+  if (request_key_length >= (sizeof(request_key) - 1))
+  {
+    return function.functor();
+  }
+  hash_stream_.reset();
+  hash_stream_.write((const uint8_t *)request_key,request_key_length);
+  uint32_t request_hash = hash_stream_.getHash();
+
+  const char * result_json;
+  size_t result_length;
+  if (!result_cache_.find(&function,request_hash,result_json,result_length,request_key,request_key_length) &&
+    result_cache_.beginCapture(&function,request_hash,request_key,request_key_length))
+  {
+    // capture only the result value, the result key is written to the
+    // server stream when the value is copied out
+    JsonStream result_cache_json_stream(result_cache_);
+    result_cache_json_stream.setCompactPrint();
+    response_.setJsonStream(result_cache_json_stream);
+    response_.setResultKeyInResponse(true);
+    bool functor_ok = function.functor();
+    response_.setJsonStream(server_json_stream_);
+    result_cache_.endCapture(functor_ok && !response_.error());
+    response_.reset();
+  }
+
+  if (result_cache_.find(&function,request_hash,result_json,result_length,request_key,request_key_length))
+  {
+    response_.writeResultKey();
+    response_.writeSerialized(result_json,result_length);
+    return true;
+  }
+  // nothing usable was captured, so run the handler again on the server stream
+  return function.functor();
+}
+
 bool Server::checkParameters(Function & function,
   size_t request_array_start_index)
 {
@@ -881,8 +1274,10 @@ bool Server::checkParameters(Function & function,
     }
     Parameter * parameter_ptr = NULL;
     parameter_ptr = function.parameter_ptrs_[parameter_index];
-    if (checkParameter(*parameter_ptr,value))
+    Argument & argument = request_arguments_[parameter_index];
+    if (checkParameter(*parameter_ptr,value,argument))
     {
+      parameter_ptr->setArgument(argument);
       ++parameter_index;
     }
     else
@@ -893,294 +1288,85 @@ bool Server::checkParameters(Function & function,
   return true;
 }
 
-bool Server::checkParameter(Parameter & parameter,
-  ArduinoJson::JsonVariant json_value)
-{
-  bool correct_type = true;
-  bool in_subset = true;
-  bool in_range = true;
-  bool array_length_in_range = true;
-  bool array_elements_ok = true;
-  char min_str[JsonStream::STRING_LENGTH_DOUBLE];
-  min_str[0] = '\0';
-  char max_str[JsonStream::STRING_LENGTH_DOUBLE];
-  max_str[0] = '\0';
-  JsonStream::JsonTypes type = parameter.getType();
-  switch (type)
-  {
-    case JsonStream::LONG_TYPE:
-    {
-      if (!json_value.is<signed long>())
-      {
-        correct_type = false;
-        break;
-      }
-      long value = json_value.as<signed long>();
-      if (!parameter.valueInSubset(value))
-      {
-        in_subset = false;
-        break;
-      }
-      if (!parameter.valueInRange(value))
-      {
-        in_range = false;
-        long min = parameter.getRangeMin().l;
-        long max = parameter.getRangeMax().l;
-        dtostrf(min,0,0,min_str);
-        dtostrf(max,0,0,max_str);
-      }
-      break;
-    }
-    case JsonStream::DOUBLE_TYPE:
-    {
-      if (!json_value.is<double>())
-      {
-        correct_type = false;
-        break;
-      }
-      double value = json_value.as<double>();
-      if (!parameter.valueInRange(value))
-      {
-        in_range = false;
-        double min = parameter.getRangeMin().d;
-        double max = parameter.getRangeMax().d;
-        dtostrf(min,0,JsonStream::DOUBLE_DIGITS_DEFAULT,min_str);
-        dtostrf(max,0,JsonStream::DOUBLE_DIGITS_DEFAULT,max_str);
-      }
-      break;
-    }
-    case JsonStream::BOOL_TYPE:
-    {
-      if (!json_value.is<bool>())
-      {
-        correct_type = false;
-      }
-      break;
-    }
-    case JsonStream::NULL_TYPE:
-    {
-      break;
-    }
-    case JsonStream::STRING_TYPE:
-    {
-      if (!json_value.is<const char *>())
-      {
-        correct_type = false;
-        break;
-      }
-      const char * value = json_value.as<const char *>();
-      if (!parameter.valueInSubset(value))
-      {
-        in_subset = false;
-      }
-      break;
-    }
-    case JsonStream::OBJECT_TYPE:
-    {
-      if (!json_value.is<ArduinoJson::JsonObject>())
-      {
-        correct_type = false;
-        break;
-      }
-      break;
-    }
-    case JsonStream::ARRAY_TYPE:
-    {
-      if (!json_value.is<ArduinoJson::JsonArray>())
-      {
-        correct_type = false;
-        break;
-      }
-      ArduinoJson::JsonArray json_array = json_value.as<ArduinoJson::JsonArray>();
-      size_t array_length = json_array.size();
-      if (!parameter.arrayLengthInRange(array_length))
-      {
-        array_length_in_range = false;
-        size_t array_length_min = parameter.getArrayLengthMin();
-        size_t array_length_max = parameter.getArrayLengthMax();
-        dtostrf(array_length_min,0,0,min_str);
-        dtostrf(array_length_max,0,0,max_str);
-        break;
-      }
-      for (ArduinoJson::JsonVariant value : json_array)
-      {
-        bool parameter_ok = checkArrayParameterElement(parameter,value);
-        if (!parameter_ok)
-        {
-          array_elements_ok = false;
-          break;
-        }
-      }
-      break;
-    }
-    case JsonStream::ANY_TYPE:
-    {
-      break;
-    }
-  }
-  if (!correct_type)
-  {
-    response_.returnParameterIncorrectTypeError(parameter.getName());
-  }
-  else if (!in_subset)
-  {
-    Vector<constants::SubsetMemberType> & subset = parameter.getSubset();
-    char subset_str[constants::STRING_LENGTH_ERROR];
-    subset_str[0] = '\0';
-    subsetToString(subset_str,
-      subset,
-      parameter.getType(),
-      parameter.getArrayElementType(),
-      constants::STRING_LENGTH_ERROR-1);
-    response_.returnParameterNotInSubsetError(subset_str,
-      parameter.getType());
-  }
-  else if (!in_range)
-  {
-    response_.returnParameterNotInRangeError(parameter.getName(),
-      parameter.getType(),
-      min_str,
-      max_str);
-  }
-  else if (!array_length_in_range)
+void Server::clearArguments(Function & function)
+{
+  for (size_t i=0; i<function.parameter_ptrs_.size(); ++i)
   {
-    response_.returnParameterArrayLengthError(parameter.getName(),min_str,max_str);
+    function.parameter_ptrs_[i]->clearArgument();
   }
-  bool parameter_ok = in_subset && in_range && array_length_in_range && array_elements_ok;
-  return parameter_ok;
 }
 
-bool Server::checkArrayParameterElement(Parameter & parameter,
-  ArduinoJson::JsonVariant json_value)
+bool Server::checkParameter(Parameter & parameter,
+  ArduinoJson::JsonVariant json_value,
+  Argument & argument)
 {
-  bool in_subset = true;
-  bool in_range = true;
-  char min_str[JsonStream::STRING_LENGTH_DOUBLE];
-  min_str[0] = '\0';
-  char max_str[JsonStream::STRING_LENGTH_DOUBLE];
-  max_str[0] = '\0';
-  JsonStream::JsonTypes type = parameter.getType();
-  switch (type)
+  parameter::ValidatorResult result = parameter.validate(json_value,argument);
+  switch (result)
   {
-    case JsonStream::LONG_TYPE:
-    {
-      break;
-    }
-    case JsonStream::DOUBLE_TYPE:
-    {
-      break;
-    }
-    case JsonStream::BOOL_TYPE:
-    {
-      break;
-    }
-    case JsonStream::NULL_TYPE:
+    case parameter::VALID:
     {
-      break;
+      return true;
     }
-    case JsonStream::STRING_TYPE:
+    case parameter::INCORRECT_TYPE:
     {
+      response_.returnParameterIncorrectTypeError(parameter.getName());
       break;
     }
-    case JsonStream::OBJECT_TYPE:
+    case parameter::NOT_IN_SUBSET:
     {
+      Vector<constants::SubsetMemberType> & subset = parameter.getSubset();
+      char subset_str[constants::STRING_LENGTH_ERROR];
+      subset_str[0] = '\0';
+      subsetToString(subset_str,
+        subset,
+        parameter.getType(),
+        parameter.getArrayElementType(),
+        constants::STRING_LENGTH_ERROR-1);
+      response_.returnParameterNotInSubsetError(subset_str,
+        parameter.getType());
       break;
     }
-    case JsonStream::ARRAY_TYPE:
+    case parameter::NOT_IN_RANGE:
     {
-      JsonStream::JsonTypes array_element_type = parameter.getArrayElementType();
-      switch (array_element_type)
+      char min_str[constants::STRING_LENGTH_DOUBLE];
+      min_str[0] = '\0';
+      char max_str[constants::STRING_LENGTH_DOUBLE];
+      max_str[0] = '\0';
+      JsonStream::JsonTypes type = parameter.getType();
+      if (type == JsonStream::ARRAY_TYPE)
       {
-        case JsonStream::LONG_TYPE:
-        {
-          long value = json_value.as<long>();
-          if (!parameter.valueInSubset(value))
-          {
-            in_subset = false;
-            break;
-          }
-          if (!parameter.valueInRange(value))
-          {
-            in_range = false;
-            long min = parameter.getRangeMin().l;
-            long max = parameter.getRangeMax().l;
-            dtostrf(min,0,0,min_str);
-            dtostrf(max,0,0,max_str);
-          }
-          break;
-        }
-        case JsonStream::DOUBLE_TYPE:
-        {
-          double value = json_value.as<double>();
-          if (!parameter.valueInRange(value))
-          {
-            in_range = false;
-            double min = parameter.getRangeMin().d;
-            double max = parameter.getRangeMax().d;
-            dtostrf(min,0,JsonStream::DOUBLE_DIGITS_DEFAULT,min_str);
-            dtostrf(max,0,JsonStream::DOUBLE_DIGITS_DEFAULT,max_str);
-          }
-          break;
-        }
-        case JsonStream::BOOL_TYPE:
-        {
-          break;
-        }
-        case JsonStream::NULL_TYPE:
-        {
-          break;
-        }
-        case JsonStream::STRING_TYPE:
-        {
-          const char * value = json_value.as<const char *>();
-          if (!parameter.valueInSubset(value))
-          {
-            in_subset = false;
-          }
-          break;
-        }
-        case JsonStream::OBJECT_TYPE:
-        {
-          break;
-        }
-        case JsonStream::ARRAY_TYPE:
-        {
-          break;
-        }
-        case JsonStream::ANY_TYPE:
-        {
-          break;
-        }
+        type = parameter.getArrayElementType();
+      }
+      if (type == JsonStream::LONG_TYPE)
+      {
+        ltoa(parameter.getRangeMin().l,min_str,10);
+        ltoa(parameter.getRangeMax().l,max_str,10);
       }
+      else
+      {
+        DoubleFormatter::toString(parameter.getRangeMin().d,min_str);
+        DoubleFormatter::toString(parameter.getRangeMax().d,max_str);
+      }
+      response_.returnParameterNotInRangeError(parameter.getName(),
+        parameter.getType(),
+        min_str,
+        max_str,
+        argument.element_index);
       break;
     }
-    case JsonStream::ANY_TYPE:
+    case parameter::ARRAY_LENGTH_NOT_IN_RANGE:
     {
+      char min_str[JsonStream::STRING_LENGTH_DOUBLE];
+      min_str[0] = '\0';
+      char max_str[JsonStream::STRING_LENGTH_DOUBLE];
+      max_str[0] = '\0';
+      ltoa(parameter.getArrayLengthMin(),min_str,10);
+      ltoa(parameter.getArrayLengthMax(),max_str,10);
+      response_.returnParameterArrayLengthError(parameter.getName(),min_str,max_str);
       break;
     }
   }
-  if (!in_subset)
-  {
-    Vector<constants::SubsetMemberType> & subset = parameter.getSubset();
-    char subset_str[constants::STRING_LENGTH_ERROR];
-    subset_str[0] = '\0';
-    subsetToString(subset_str,
-      subset,
-      parameter.getType(),
-      parameter.getArrayElementType(),
-      constants::STRING_LENGTH_ERROR-1);
-    response_.returnParameterNotInSubsetError(subset_str,
-      parameter.getType());
-  }
-  else if (!in_range)
-  {
-    response_.returnParameterNotInRangeError(parameter.getName(),
-      parameter.getType(),
-      min_str,
-      max_str);
-  }
-  bool parameter_ok = in_subset && in_range;
-  return parameter_ok;
+  return false;
 }
 
 long Server::getSerialNumber()
@@ -1202,11 +1388,53 @@ void Server::initializeEeprom()
 
 void Server::incrementServerStream()
 {
-  if (server_stream_ptrs_.size() > 0)
+  if (server_streams_.size() > 0)
+  {
+    server_stream_index_ = (server_stream_index_ + 1) % server_streams_.size();
+    server_stream_credit_ = server_streams_[server_stream_index_].getWeight();
+  }
+}
+
+void Server::processRequest(ServerStream & server_stream)
+{
+  if (server_stream.requestOverflow())
   {
-    server_stream_index_ = (server_stream_index_ + 1) % server_stream_ptrs_.size();
-    server_json_stream_.setStream(*server_stream_ptrs_[server_stream_index_]);
+    response_.setCompactPrint();
+    response_.begin();
+    response_.returnError(constants::request_length_error_data);
+    response_.end();
+    return;
   }
+  updateElementIndexes();
+  char * request = server_stream.getRequest();
+  bool request_parsed = request_parser_.parse(request,request_json_document_);
+  if (request_parser_.empty())
+  {
+    return;
+  }
+  if (request_parser_.compact())
+  {
+    response_.setCompactPrint();
+  }
+  else
+  {
+    response_.setPrettyPrint();
+  }
+  response_.begin();
+  if (request_parser_.object())
+  {
+    response_.returnError(constants::object_request_error_data);
+  }
+  else if (request_parsed)
+  {
+    request_json_array_ = request_json_document_.as<ArduinoJson::JsonArray>();
+    processRequestArray();
+  }
+  else
+  {
+    response_.returnRequestParseError(request);
+  }
+  response_.end();
 }
 
 void Server::help(bool verbose)
@@ -1219,8 +1447,6 @@ void Server::help(bool verbose)
   size_t request_element_count = request_json_array_.size();
 
   const char * parameter0_string = getRequestElementAsString(1,request_element_count);
-  const char * parameter1_string = getRequestElementAsString(2,request_element_count);
-  const char * parameter2_string = getRequestElementAsString(3,request_element_count);
 
   int parameter_count = request_element_count - 1;
   bool param_error = true;
@@ -1279,7 +1505,7 @@ void Server::help(bool verbose)
       // ? function
       param_error = false;
       response_.writeResultKey();
-      Function & function = functions_[function_index];
+      Function & function = functionAt(function_index);
       function.writeApi(response_,false,true,true,verbose);
     }
     else
@@ -1291,7 +1517,7 @@ void Server::help(bool verbose)
         // ?? parameter
         param_error = false;
         response_.writeResultKey();
-        Parameter & parameter = parameters_[parameter_index];
+        Parameter & parameter = parameterAt(parameter_index);
         parameter.writeApi(response_,false,false,false,true,true);
       }
       else
@@ -1303,7 +1529,7 @@ void Server::help(bool verbose)
           // ?? property
           param_error = false;
           response_.writeResultKey();
-          Property & property = properties_[property_index];
+          Property & property = propertyAt(property_index);
           property.writeApi(response_,false,true,true,verbose,true);
         }
         else
@@ -1315,7 +1541,7 @@ void Server::help(bool verbose)
             // ?? callback
             param_error = false;
             response_.writeResultKey();
-            Callback & callback = callbacks_[callback_index];
+            Callback & callback = callbackAt(callback_index);
             callback.writeApi(response_,false,true,true,verbose,verbose,true);
           }
         }
@@ -1332,9 +1558,9 @@ void Server::help(bool verbose)
     int function_index = findFunctionIndex(method_string);
     if (function_index >= 0)
     {
-      Function & function = functions_[function_index];
+      Function & function = functionAt(function_index);
 
-      int parameter_index = processParameterString(function,parameter1_string);
+      int parameter_index = processParameterElement(function,2);
       if (parameter_index >= 0)
       {
         param_error = false;
@@ -1348,9 +1574,9 @@ void Server::help(bool verbose)
       int property_index = findPropertyIndex(method_string);
       if (property_index >= 0)
       {
-        Property & property = properties_[property_index];
+        Property & property = propertyAt(property_index);
         property.updateFunctionsAndParameters();
-        int property_function_index = property.findFunctionIndex(parameter1_string);
+        int property_function_index = findMethodFunctionIndex(property,2);
         if (property_function_index >= 0)
         {
           param_error = false;
@@ -1380,13 +1606,13 @@ void Server::help(bool verbose)
     int property_index = findPropertyIndex(method_string);
     if (property_index >= 0)
     {
-      Property & property = properties_[property_index];
+      Property & property = propertyAt(property_index);
       property.updateFunctionsAndParameters();
-      int property_function_index = property.findFunctionIndex(parameter1_string);
+      int property_function_index = findMethodFunctionIndex(property,2);
       if (property_function_index >= 0)
       {
         Function & function = property.functions_[property_function_index];
-        int parameter_index = processParameterString(function,parameter2_string);
+        int parameter_index = processParameterElement(function,3);
         if (parameter_index >= 0)
         {
           param_error = false;
@@ -1613,7 +1839,7 @@ void Server::writePinInfoToResponse(const ConstantString & pin_name)
   {
     for (size_t i=0; i<pins_.size(); ++i)
     {
-      Pin & pin = pins_[i];
+      Pin & pin = pinAt(i);
       pin.writeApi(response_,false,true);
     }
   }
@@ -1636,12 +1862,72 @@ void Server::writeApiToResponse(const ConstantString & verbosity,
     return;
   }
 
+  constants::FirmwareMask firmware_mask = getFirmwareMask(firmware_name_array);
+  if (!apiCacheable(verbosity,firmware_name_array,firmware_mask))
+  {
+    writeApiObjectToResponse(verbosity,firmware_name_array,firmware_mask);
+    return;
+  }
+
+  const char * api_json;
+  size_t api_length;
+  if (!api_cache_.find(&verbosity,firmware_mask,api_json,api_length) &&
+    api_cache_.beginCapture(&verbosity,firmware_mask))
+  {
+    // serialize once into the cache instead of the server stream
+    JsonStream api_cache_json_stream(api_cache_);
+    api_cache_json_stream.setCompactPrint();
+    response_.setJsonStream(api_cache_json_stream);
+    writeApiObjectToResponse(verbosity,firmware_name_array,firmware_mask);
+    response_.setJsonStream(server_json_stream_);
+    api_cache_.endCapture();
+  }
+
+  if (api_cache_.find(&verbosity,firmware_mask,api_json,api_length))
+  {
+    response_.writeSerialized(api_json,api_length);
+  }
+  else
+  {
+    writeApiObjectToResponse(verbosity,firmware_name_array,firmware_mask);
+  }
+}
+
+void Server::writeApiObjectToResponse(const ConstantString & verbosity,
+  ArduinoJson::JsonArray firmware_name_array,
+  constants::FirmwareMask firmware_mask)
+{
+  if (response_.error())
+  {
+    return;
+  }
+
   response_.beginObject();
+  writeApiMembersToResponse(verbosity,firmware_name_array,firmware_mask,0,0);
+  response_.endObject();
+}
 
-  writeAncestorsToResponse(firmware_name_array);
-  writeFirmwareInfoToResponse(firmware_name_array);
+size_t Server::writeApiMembersToResponse(const ConstantString & verbosity,
+  ArduinoJson::JsonArray firmware_name_array,
+  constants::FirmwareMask firmware_mask,
+  size_t cursor,
+  size_t page_size)
+{
+  // cursor counts the functions, parameters, properties and callbacks
+  // written so far, in that order, zero page_size writes them all
+  size_t page_end = cursor + page_size;
+  if (page_size == 0)
+  {
+    page_end = (size_t)-1;
+  }
+
+  if (cursor == 0)
+  {
+    writeAncestorsToResponse(firmware_name_array);
+    writeFirmwareInfoToResponse(firmware_name_array);
 
-  response_.write(constants::verbosity_constant_string,verbosity);
+    response_.write(constants::verbosity_constant_string,verbosity);
+  }
 
   bool write_names_only = false;
   bool write_instance_details = false;
@@ -1661,143 +1947,310 @@ void Server::writeApiToResponse(const ConstantString & verbosity,
     write_firmware = true;
   }
 
-  size_t functions_count = getFunctionsCount(firmware_name_array);
-  if (functions_count > 0)
+  size_t position = 0;
+  bool section_begun = false;
+  for (size_t function_index=0; function_index<functions_.size(); ++function_index)
   {
-    response_.writeKey(constants::functions_constant_string);
-    response_.beginArray();
-    for (size_t function_index=0; function_index<functions_.size(); ++function_index)
+    if (function_index > private_function_index_)
     {
-      if (function_index > private_function_index_)
+      Function & function = functionAt(function_index);
+      if (function.firmwareInMask(firmware_mask) &&
+        apiElementInPage(position,cursor,page_end,section_begun,constants::functions_constant_string))
       {
-        Function & function = functions_[function_index];
-        if (function.firmwareNameInArray(firmware_name_array))
-        {
-          function.writeApi(response_,write_names_only,false,write_firmware,false);
-        }
+        function.writeApi(response_,write_names_only,false,write_firmware,false);
       }
     }
-    response_.endArray();
   }
+  endApiSection(section_begun);
 
-  size_t parameters_count = getParametersCount(firmware_name_array);
-  if (parameters_count > 0)
+  section_begun = false;
+  for (size_t parameter_index=0; parameter_index<parameters_.size(); ++parameter_index)
   {
-    response_.writeKey(constants::parameters_constant_string);
-    response_.beginArray();
-    for (size_t parameter_index=0; parameter_index<parameters_.size(); ++parameter_index)
+    Parameter & parameter = parameterAt(parameter_index);
+    if (parameter.firmwareInMask(firmware_mask) &&
+      apiElementInPage(position,cursor,page_end,section_begun,constants::parameters_constant_string))
     {
-      Parameter & parameter = parameters_[parameter_index];
-      if (parameter.firmwareNameInArray(firmware_name_array))
-      {
-        parameter.writeApi(response_,write_names_only,false,false,write_firmware,write_instance_details);
-      }
+      parameter.writeApi(response_,write_names_only,false,false,write_firmware,write_instance_details);
     }
-    response_.endArray();
   }
+  endApiSection(section_begun);
 
-  size_t properties_count = getPropertiesCount(firmware_name_array);
-  if (properties_count > 0)
+  section_begun = false;
+  for (size_t property_index=0; property_index<properties_.size(); ++property_index)
   {
-    response_.writeKey(constants::properties_constant_string);
-    response_.beginArray();
-    for (size_t property_index=0; property_index<properties_.size(); ++property_index)
+    Property & property = propertyAt(property_index);
+    if (property.firmwareInMask(firmware_mask) &&
+      apiElementInPage(position,cursor,page_end,section_begun,constants::properties_constant_string))
     {
-      Property & property = properties_[property_index];
-      if (property.firmwareNameInArray(firmware_name_array))
-      {
-        property.writeApi(response_,write_names_only,false,write_firmware,true,write_instance_details);
-      }
+      property.writeApi(response_,write_names_only,false,write_firmware,true,write_instance_details);
     }
-    response_.endArray();
   }
+  endApiSection(section_begun);
 
-  size_t callbacks_count = getCallbacksCount(firmware_name_array);
-  if (callbacks_count > 0)
+  section_begun = false;
+  for (size_t callback_index=0; callback_index<callbacks_.size(); ++callback_index)
   {
-    response_.writeKey(constants::callbacks_constant_string);
-    response_.beginArray();
-    for (size_t callback_index=0; callback_index<callbacks_.size(); ++callback_index)
+    Callback & callback = callbackAt(callback_index);
+    if (callback.firmwareInMask(firmware_mask) &&
+      apiElementInPage(position,cursor,page_end,section_begun,constants::callbacks_constant_string))
     {
-      Callback & callback = callbacks_[callback_index];
-      if (callback.firmwareNameInArray(firmware_name_array))
-      {
-        callback.writeApi(response_,write_names_only,false,write_firmware,true,false,write_instance_details);
-      }
+      callback.writeApi(response_,write_names_only,false,write_firmware,true,false,write_instance_details);
     }
+  }
+  endApiSection(section_begun);
+
+  if (position > page_end)
+  {
+    return page_end;
+  }
+  return 0;
+}
+
+bool Server::apiElementInPage(size_t & position,
+  size_t cursor,
+  size_t page_end,
+  bool & section_begun,
+  const ConstantString & section_key)
+{
+  bool in_page = ((position >= cursor) && (position < page_end));
+  ++position;
+  if (in_page && !section_begun)
+  {
+    // sections without elements in the page are left out
+    response_.writeKey(section_key);
+    response_.beginArray();
+    section_begun = true;
+  }
+  return in_page;
+}
+
+void Server::endApiSection(bool section_begun)
+{
+  if (section_begun)
+  {
     response_.endArray();
   }
+}
 
-  response_.endObject();
+void Server::writeCursorToResponse(size_t next_cursor)
+{
+  // null cursor marks the last page
+  if (next_cursor > 0)
+  {
+    response_.write(constants::cursor_constant_string,(long)next_cursor);
+  }
+  else
+  {
+    response_.writeNull(constants::cursor_constant_string);
+  }
 }
 
-bool Server::containsAllOrMoreThanOne(ArduinoJson::JsonArray firmware_name_array)
+bool Server::apiCacheable(const ConstantString & verbosity,
+  ArduinoJson::JsonArray firmware_name_array,
+  constants::FirmwareMask firmware_mask)
 {
-  if (firmware_name_array.size() > 1)
+  // detailed verbosity writes live instance values and pretty printing
+  // depends on where the api is nested in the response
+  if ((&verbosity == &constants::verbosity_detailed) || !request_parser_.compact())
   {
-    return true;
+    return false;
   }
-  for (ArduinoJson::JsonVariant value : firmware_name_array)
+  // the cached api must be fully determined by the firmware mask, so each
+  // requested firmware name must select exactly one firmware
+  if (firmware_mask == constants::firmware_mask_all)
   {
-    const char * firmware_name_to_compare = value.as<const char *>();
-    if (firmware_name_to_compare == constants::all_constant_string)
+    return (firmware_name_array.size() == 1);
+  }
+  size_t firmware_count = 0;
+  for (size_t firmware_index=0; firmware_index<firmware_info_array_.size(); ++firmware_index)
+  {
+    if (firmware_mask & (1 << firmware_index))
     {
-      return true;
+      ++firmware_count;
     }
   }
-  return false;
+  return (firmware_count == firmware_name_array.size());
 }
 
-size_t Server::getPropertiesCount(ArduinoJson::JsonArray firmware_name_array)
+void Server::apiChanged()
 {
-  size_t count = 0;
-  for (size_t property_index=0; property_index<properties_.size(); ++property_index)
+  api_cache_.clear();
+  api_hashes_valid_ = false;
+  resultsChanged();
+}
+
+void Server::resultsChanged()
+{
+  result_cache_.clear();
+}
+
+void Server::propertyValueChanged(Property & property)
+{
+  // cached device id and info results include the serial number
+  if (property.compareName(constants::serial_number_property_name))
   {
-    if (properties_[property_index].firmwareNameInArray(firmware_name_array))
+    resultsChanged();
+  }
+}
+
+void Server::updateApiHashes()
+{
+  ArduinoJson::StaticJsonDocument<constants::FIRMWARE_NAME_JSON_DOCUMENT_SIZE> json_document;
+  for (size_t firmware_index=0; firmware_index<=firmware_info_array_.size(); ++firmware_index)
+  {
+    // one hash per single firmware, then one for all firmware
+    const ConstantString * firmware_name_ptr = &constants::all_constant_string;
+    if (firmware_index < firmware_info_array_.size())
+    {
+      firmware_name_ptr = firmware_info_array_[firmware_index]->name_ptr;
+    }
+    char firmware_name_str[firmware_name_ptr->length() + 1];
+    firmware_name_str[0] = '\0';
+    firmware_name_ptr->copy(firmware_name_str);
+    ArduinoJson::JsonArray firmware_name_array = json_document.to<ArduinoJson::JsonArray>();
+    firmware_name_array.add<char *>(firmware_name_str);
+    constants::FirmwareMask firmware_mask = getFirmwareMask(firmware_name_array);
+
+    int names_index = getApiHashIndex(constants::verbosity_names,firmware_name_array,firmware_mask);
+    if (names_index >= 0)
+    {
+      api_hashes_[names_index] = computeApiHash(constants::verbosity_names,firmware_name_array,firmware_mask);
+    }
+    int general_index = getApiHashIndex(constants::verbosity_general,firmware_name_array,firmware_mask);
+    if (general_index >= 0)
     {
-      ++count;
+      api_hashes_[general_index] = computeApiHash(constants::verbosity_general,firmware_name_array,firmware_mask);
     }
   }
-  return count;
+  api_hashes_valid_ = true;
+}
+
+uint32_t Server::getApiHash(const ConstantString & verbosity,
+  ArduinoJson::JsonArray firmware_name_array)
+{
+  constants::FirmwareMask firmware_mask = getFirmwareMask(firmware_name_array);
+  int index = getApiHashIndex(verbosity,firmware_name_array,firmware_mask);
+  if (api_hashes_valid_ && (index >= 0))
+  {
+    return api_hashes_[index];
+  }
+  return computeApiHash(verbosity,firmware_name_array,firmware_mask);
+}
+
+uint32_t Server::computeApiHash(const ConstantString & verbosity,
+  ArduinoJson::JsonArray firmware_name_array,
+  constants::FirmwareMask firmware_mask)
+{
+  // hash the compact serialization so the hash does not depend on how the
+  // request was formatted
+  hash_stream_.reset();
+  JsonStream hash_json_stream(hash_stream_);
+  hash_json_stream.setCompactPrint();
+  response_.setJsonStream(hash_json_stream);
+  writeApiObjectToResponse(verbosity,firmware_name_array,firmware_mask);
+  response_.setJsonStream(server_json_stream_);
+  return hash_stream_.getHash();
 }
 
-size_t Server::getParametersCount(ArduinoJson::JsonArray firmware_name_array)
+int Server::getApiHashIndex(const ConstantString & verbosity,
+  ArduinoJson::JsonArray firmware_name_array,
+  constants::FirmwareMask firmware_mask)
 {
-  size_t count = 0;
-  for (size_t property_index=0; property_index<parameters_.size(); ++property_index)
+  // detailed verbosity and firmware combinations are hashed on request
+  if (firmware_name_array.size() != 1)
+  {
+    return -1;
+  }
+  int verbosity_index;
+  if (&verbosity == &constants::verbosity_names)
+  {
+    verbosity_index = 0;
+  }
+  else if (&verbosity == &constants::verbosity_general)
+  {
+    verbosity_index = 1;
+  }
+  else
+  {
+    return -1;
+  }
+  int firmware_index = -1;
+  if (firmware_mask == constants::firmware_mask_all)
   {
-    if (parameters_[property_index].firmwareNameInArray(firmware_name_array))
+    firmware_index = constants::FIRMWARE_COUNT_MAX;
+  }
+  else
+  {
+    for (size_t i=0; i<firmware_info_array_.size(); ++i)
     {
-      ++count;
+      if (firmware_mask == (1 << i))
+      {
+        firmware_index = i;
+      }
     }
   }
-  return count;
+  if (firmware_index < 0)
+  {
+    return -1;
+  }
+  return verbosity_index*constants::API_HASH_FIRMWARE_SLOT_COUNT + firmware_index;
+}
+
+const ConstantString * Server::findVerbosityPtr(const char * verbosity)
+{
+  if (verbosity == constants::verbosity_names)
+  {
+    return &constants::verbosity_names;
+  }
+  else if (verbosity == constants::verbosity_general)
+  {
+    return &constants::verbosity_general;
+  }
+  else if (verbosity == constants::verbosity_detailed)
+  {
+    return &constants::verbosity_detailed;
+  }
+  return NULL;
 }
 
-size_t Server::getFunctionsCount(ArduinoJson::JsonArray firmware_name_array)
+bool Server::containsAllOrMoreThanOne(ArduinoJson::JsonArray firmware_name_array)
 {
-  size_t count = 0;
-  for (size_t property_index=0; property_index<functions_.size(); ++property_index)
+  if (firmware_name_array.size() > 1)
+  {
+    return true;
+  }
+  for (ArduinoJson::JsonVariant value : firmware_name_array)
   {
-    if (functions_[property_index].firmwareNameInArray(firmware_name_array))
+    const char * firmware_name_to_compare = value.as<const char *>();
+    if (firmware_name_to_compare == constants::all_constant_string)
     {
-      ++count;
+      return true;
     }
   }
-  return count;
+  return false;
 }
 
-size_t Server::getCallbacksCount(ArduinoJson::JsonArray firmware_name_array)
+constants::FirmwareMask Server::getFirmwareMask(ArduinoJson::JsonArray firmware_name_array)
 {
-  size_t count = 0;
-  for (size_t property_index=0; property_index<callbacks_.size(); ++property_index)
+  // firmware names are compared once per request, elements then only test
+  // their firmware bit
+  constants::FirmwareMask firmware_mask = 0;
+  for (ArduinoJson::JsonVariant value : firmware_name_array)
   {
-    if (callbacks_[property_index].firmwareNameInArray(firmware_name_array))
+    const char * firmware_name = value.as<const char *>();
+    if (constants::all_constant_string == firmware_name)
     {
-      ++count;
+      return constants::firmware_mask_all;
+    }
+    for (size_t firmware_index=0; firmware_index<firmware_info_array_.size(); ++firmware_index)
+    {
+      if (*(firmware_info_array_[firmware_index]->name_ptr) == firmware_name)
+      {
+        firmware_mask |= 1 << firmware_index;
+      }
     }
   }
-  return count;
+  return firmware_mask;
 }
 
 void Server::versionToString(char* destination,
@@ -1946,28 +2399,38 @@ void Server::getMethodIdsHandler()
 {
   response_.writeResultKey();
   response_.beginObject();
-  size_t method_index;
+  int method_id;
   for (size_t function_index=0; function_index<functions_.size(); ++function_index)
   {
     if (function_index > private_function_index_)
     {
-      const ConstantString & function_name = functions_[function_index].getName();
-      method_index = function_index;
-      response_.write(function_name,method_index);
+      const ConstantString & function_name = functionAt(function_index).getName();
+      method_id = getMethodId(function_index);
+      if (method_id >= 0)
+      {
+        response_.write(function_name,method_id);
+      }
     }
   }
   for (size_t callback_index=0; callback_index<callbacks_.size(); ++callback_index)
   {
-    const ConstantString & callback_name = callbacks_[callback_index].getName();
-    method_index = callback_index + functions_.size();
-    response_.write(callback_name,method_index);
+    const ConstantString & callback_name = callbackAt(callback_index).getName();
+    method_id = getMethodId(callback_index + functions_.size());
+    if (method_id >= 0)
+    {
+      response_.write(callback_name,method_id);
+    }
   }
   for (size_t property_index=0; property_index<properties_.size(); ++property_index)
   {
-    const ConstantString & property_name = properties_[property_index].getName();
-    method_index = property_index + functions_.size() + callbacks_.size();
-    response_.write(property_name,method_index);
+    const ConstantString & property_name = propertyAt(property_index).getName();
+    method_id = getMethodId(property_index + functions_.size() + callbacks_.size());
+    if (method_id >= 0)
+    {
+      response_.write(property_name,method_id);
+    }
   }
+
   response_.endObject();
 }
 
@@ -2002,18 +2465,94 @@ void Server::getApiHandler()
   parameter(constants::firmware_constant_string).getValue(firmware_name_array);
   response_.writeResultKey();
 
-  if (verbosity == constants::verbosity_names)
+  const ConstantString * verbosity_ptr = findVerbosityPtr(verbosity);
+  if (verbosity_ptr)
   {
-    writeApiToResponse(constants::verbosity_names,firmware_name_array);
+    writeApiToResponse(*verbosity_ptr,firmware_name_array);
   }
-  else if (verbosity == constants::verbosity_general)
+}
+
+void Server::getApiHashHandler()
+{
+  const char * verbosity;
+  parameter(constants::verbosity_constant_string).getValue(verbosity);
+
+  ArduinoJson::JsonArray firmware_name_array;
+  parameter(constants::firmware_constant_string).getValue(firmware_name_array);
+
+  const ConstantString * verbosity_ptr = findVerbosityPtr(verbosity);
+  if (verbosity_ptr)
   {
-    writeApiToResponse(constants::verbosity_general,firmware_name_array);
+    char api_hash_str[constants::STRING_LENGTH_API_HASH];
+    HashStream::hashToString(getApiHash(*verbosity_ptr,firmware_name_array),api_hash_str);
+    response_.returnResult((const char *)api_hash_str);
   }
-  else if (verbosity == constants::verbosity_detailed)
+}
+
+void Server::getApiIfChangedHandler()
+{
+  const char * verbosity;
+  parameter(constants::verbosity_constant_string).getValue(verbosity);
+
+  ArduinoJson::JsonArray firmware_name_array;
+  parameter(constants::firmware_constant_string).getValue(firmware_name_array);
+
+  const char * client_api_hash;
+  parameter(constants::api_hash_parameter_name).getValue(client_api_hash);
+
+  const ConstantString * verbosity_ptr = findVerbosityPtr(verbosity);
+  if (!verbosity_ptr)
+  {
+    return;
+  }
+
+  char api_hash_str[constants::STRING_LENGTH_API_HASH];
+  HashStream::hashToString(getApiHash(*verbosity_ptr,firmware_name_array),api_hash_str);
+
+  response_.writeResultKey();
+  if (strcasecmp(client_api_hash,api_hash_str) == 0)
+  {
+    response_.beginObject();
+    response_.write(constants::unchanged_constant_string,true);
+    response_.endObject();
+  }
+  else
+  {
+    writeApiToResponse(*verbosity_ptr,firmware_name_array);
+  }
+}
+
+void Server::getApiPageHandler()
+{
+  const char * verbosity;
+  parameter(constants::verbosity_constant_string).getValue(verbosity);
+
+  ArduinoJson::JsonArray firmware_name_array;
+  parameter(constants::firmware_constant_string).getValue(firmware_name_array);
+
+  long cursor;
+  parameter(constants::cursor_parameter_name).getValue(cursor);
+
+  long page_size;
+  parameter(constants::page_size_parameter_name).getValue(page_size);
+
+  const ConstantString * verbosity_ptr = findVerbosityPtr(verbosity);
+  if (!verbosity_ptr)
   {
-    writeApiToResponse(constants::verbosity_detailed,firmware_name_array);
+    return;
   }
+
+  constants::FirmwareMask firmware_mask = getFirmwareMask(firmware_name_array);
+
+  response_.writeResultKey();
+  response_.beginObject();
+  size_t next_cursor = writeApiMembersToResponse(*verbosity_ptr,
+    firmware_name_array,
+    firmware_mask,
+    cursor,
+    page_size);
+  writeCursorToResponse(next_cursor);
+  response_.endObject();
 }
 
 #ifdef __AVR__
@@ -2028,12 +2567,14 @@ void Server::getPropertyDefaultValuesHandler()
   ArduinoJson::JsonArray firmware_name_array;
   parameter(constants::firmware_constant_string).getValue(firmware_name_array);
 
+  constants::FirmwareMask firmware_mask = getFirmwareMask(firmware_name_array);
+
   response_.writeResultKey();
   response_.beginObject();
   for (size_t i=0; i<properties_.size(); ++i)
   {
-    Property & property = properties_[i];
-    if (property.parameter().firmwareNameInArray(firmware_name_array))
+    Property & property = propertyAt(i);
+    if (property.firmwareInMask(firmware_mask))
     {
       property.writeValue(response_,true,true);
     }
@@ -2046,12 +2587,14 @@ void Server::getPropertyValuesHandler()
   ArduinoJson::JsonArray firmware_name_array;
   parameter(constants::firmware_constant_string).getValue(firmware_name_array);
 
+  constants::FirmwareMask firmware_mask = getFirmwareMask(firmware_name_array);
+
   response_.writeResultKey();
   response_.beginObject();
   for (size_t i=0; i<properties_.size(); ++i)
   {
-    Property & property = properties_[i];
-    if (property.parameter().firmwareNameInArray(firmware_name_array))
+    Property & property = propertyAt(i);
+    if (property.firmwareInMask(firmware_mask))
     {
       property.writeValue(response_,true,false);
     }
@@ -2059,6 +2602,47 @@ void Server::getPropertyValuesHandler()
   response_.endObject();
 }
 
+void Server::getPropertyValuesPageHandler()
+{
+  ArduinoJson::JsonArray firmware_name_array;
+  parameter(constants::firmware_constant_string).getValue(firmware_name_array);
+
+  long cursor;
+  parameter(constants::cursor_parameter_name).getValue(cursor);
+
+  long page_size;
+  parameter(constants::page_size_parameter_name).getValue(page_size);
+
+  constants::FirmwareMask firmware_mask = getFirmwareMask(firmware_name_array);
+
+  size_t page_end = cursor + page_size;
+  size_t position = 0;
+  response_.writeResultKey();
+  response_.beginObject();
+  response_.writeKey(constants::values_constant_string);
+  response_.beginObject();
+  for (size_t i=0; i<properties_.size(); ++i)
+  {
+    Property & property = propertyAt(i);
+    if (property.firmwareInMask(firmware_mask))
+    {
+      if ((position >= (size_t)cursor) && (position < page_end))
+      {
+        property.writeValue(response_,true,false);
+      }
+      ++position;
+    }
+  }
+  response_.endObject();
+  size_t next_cursor = 0;
+  if (position > page_end)
+  {
+    next_cursor = page_end;
+  }
+  writeCursorToResponse(next_cursor);
+  response_.endObject();
+}
+
 void Server::setPropertiesToDefaultsHandler()
 {
   ArduinoJson::JsonArray firmware_name_array;
@@ -2112,4 +2696,28 @@ void Server::setPinValueHandler()
   response_.returnResult(pin_value);
 }
 
+void Server::getFunctionIdsHandler()
+{
+  // property and callback function ids are positions in their function tables
+  response_.writeResultKey();
+  response_.beginObject();
+  response_.writeKey(constants::property_functions_constant_string);
+  response_.beginObject();
+  for (int function_id=0; function_id<property::FUNCTION_ID_COUNT; ++function_id)
+  {
+    response_.write(*property::function_id_names[function_id],function_id);
+  }
+  response_.endObject();
+
+  response_.writeKey(constants::callback_functions_constant_string);
+  response_.beginObject();
+  for (int function_id=0; function_id<callback::FUNCTION_COUNT_MAX; ++function_id)
+  {
+    response_.write(*callback::function_id_names[function_id],function_id);
+  }
+  response_.endObject();
+
+  response_.endObject();
+}
+
 }
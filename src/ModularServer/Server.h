@@ -10,7 +10,6 @@
 #include <Arduino.h>
 #include <Streaming.h>
 #include <ArduinoJson.h>
-#include <JsonSanitizer.h>
 #include <Array.h>
 #include <Vector.h>
 #include <ConcatenatedArray.h>
@@ -21,11 +20,20 @@
 #include <Functor.h>
 
 #include "Property.h"
+#include "PropertyHandle.h"
 #include "Parameter.h"
 #include "Function.h"
 #include "Callback.h"
 #include "Response.h"
 #include "Pin.h"
+#include "RequestParser.h"
+#include "ServerStream.h"
+#include "HashIndex.h"
+#include "ElementTableIndex.h"
+#include "SubsetIndex.h"
+#include "ResponseCache.h"
+#include "HashStream.h"
+#include "DoubleFormatter.h"
 #include "Constants.h"
 
 
@@ -38,7 +46,9 @@ public:
   void setup();
 
   // Streams
-  void addServerStream(Stream & stream);
+  ServerStream & addServerStream(Stream & stream);
+  ServerStream & serverStream(Stream & stream);
+  void setRequestsPerCallMax(size_t requests_per_call_max);
 
   // Device ID
   void setDeviceName(const ConstantString & device_name);
@@ -65,6 +75,16 @@ public:
     Parameter (&parameters)[PARAMETERS_MAX_SIZE],
     Function (&functions)[FUNCTIONS_MAX_SIZE],
     Callback (&callbacks)[CALLBACKS_MAX_SIZE]);
+  template <size_t PROPERTIES_MAX_SIZE,
+    size_t PARAMETERS_MAX_SIZE,
+    size_t FUNCTIONS_MAX_SIZE,
+    size_t CALLBACKS_MAX_SIZE>
+  void addFirmware(const constants::FirmwareInfo & firmware_info,
+    Property (&properties)[PROPERTIES_MAX_SIZE],
+    Parameter (&parameters)[PARAMETERS_MAX_SIZE],
+    Function (&functions)[FUNCTIONS_MAX_SIZE],
+    Callback (&callbacks)[CALLBACKS_MAX_SIZE],
+    const constants::ElementTables & element_tables);
 
   // Properties
   template <typename T>
@@ -74,6 +94,15 @@ public:
     size_t N>
   Property & createProperty(const ConstantString & property_name,
     const T (&default_value)[N]);
+  template <typename T>
+  Property & createProperty(const ConstantString & property_name,
+    const T & default_value,
+    PropertyHandle<T> & property_handle);
+  template <typename T,
+    size_t N>
+  Property & createProperty(const ConstantString & property_name,
+    const T (&default_value)[N],
+    PropertyHandle<T[N]> & property_handle);
   Property & property(const ConstantString & property_name);
   template <typename T>
   void setPropertiesToDefaults(T & firmware_name_array);
@@ -101,20 +130,33 @@ public:
   void startServer();
   void stopServer();
   void handleRequest();
+  void enableStableMethodIds();
+  void disableStableMethodIds();
 
 private:
-  Array<Stream *,constants::SERVER_STREAM_COUNT_MAX> server_stream_ptrs_;
+  Array<ServerStream,constants::SERVER_STREAM_COUNT_MAX> server_streams_;
+  ServerStream dummy_server_stream_;
   size_t server_stream_index_;
+  size_t server_stream_credit_;
+  size_t requests_per_call_max_;
   JsonStream server_json_stream_;
 
+  RequestParser request_parser_;
+  ArduinoJson::StaticJsonDocument<constants::JSON_DOCUMENT_SIZE> request_json_document_;
   ArduinoJson::JsonArray request_json_array_;
 
   Response response_;
+  ResponseCache<constants::API_CACHE_SIZE,constants::API_CACHE_ENTRY_COUNT_MAX> api_cache_;
+  ResponseCache<constants::RESULT_CACHE_SIZE,constants::RESULT_CACHE_ENTRY_COUNT_MAX> result_cache_;
+  HashStream hash_stream_;
+  uint32_t api_hashes_[constants::API_HASH_COUNT_MAX];
+  bool api_hashes_valid_;
 
   Array<const constants::HardwareInfo *,constants::HARDWARE_COUNT_MAX> hardware_info_array_;
   Pin dummy_pin_;
   ConcatenatedArray<Pin,constants::HARDWARE_COUNT_MAX> pins_;
   Array<constants::SubsetMemberType,constants::PIN_COUNT_MAX+1> pin_name_array_;
+  SubsetIndex pin_name_subset_index_;
 
   Property server_properties_[constants::SERVER_PROPERTY_COUNT_MAX];
   Parameter server_parameters_[constants::SERVER_PARAMETER_COUNT_MAX];
@@ -128,13 +170,35 @@ private:
   Parameter dummy_parameter_;
   Function dummy_function_;
   Callback dummy_callback_;
+  Array<Pin *,constants::PIN_COUNT_MAX> pin_ptrs_;
+  Array<Property *,constants::PROPERTY_INDEX_SIZE> property_ptrs_;
+  Array<Parameter *,constants::PARAMETER_INDEX_SIZE> parameter_ptrs_;
+  Array<Function *,constants::FUNCTION_INDEX_SIZE> function_ptrs_;
+  Array<Callback *,constants::CALLBACK_INDEX_SIZE> callback_ptrs_;
+  ElementTableIndex<constants::PROPERTY_INDEX_SIZE> property_table_index_;
+  ElementTableIndex<constants::PARAMETER_INDEX_SIZE> parameter_table_index_;
+  ElementTableIndex<constants::FUNCTION_INDEX_SIZE> function_table_index_;
+  ElementTableIndex<constants::CALLBACK_INDEX_SIZE> callback_table_index_;
+  HashIndex<constants::PIN_NAME_INDEX_SIZE> pin_name_index_;
+  HashIndex<constants::PROPERTY_NAME_INDEX_SIZE> property_name_index_;
+  HashIndex<constants::PARAMETER_NAME_INDEX_SIZE> parameter_name_index_;
+  HashIndex<constants::FUNCTION_NAME_INDEX_SIZE> function_name_index_;
+  HashIndex<constants::CALLBACK_NAME_INDEX_SIZE> callback_name_index_;
   size_t private_function_index_;
   const ConstantString * device_name_ptr_;
   const ConstantString * form_factor_ptr_;
   Array<const constants::FirmwareInfo *,constants::FIRMWARE_COUNT_MAX> firmware_info_array_;
   Array<constants::SubsetMemberType,constants::FIRMWARE_COUNT_MAX+1> firmware_name_array_;
 
+  size_t method_index_count_;
+  bool method_index_complete_;
+  HashIndex<constants::METHOD_INDEX_SIZE> method_id_index_;
+  uint16_t method_ids_[constants::METHOD_COUNT_MAX];
+  bool method_id_valid_[constants::METHOD_COUNT_MAX];
+  bool stable_method_ids_enabled_;
+
   int request_method_index_;
+  Argument request_arguments_[constants::FUNCTION_PARAMETER_COUNT_MAX];
   int property_function_index_;
   int callback_function_index_;
   bool eeprom_initialized_;
@@ -142,6 +206,57 @@ private:
   bool server_running_;
   const char * empty_string_ = "";
 
+  void addElementTables(const constants::ElementTables & element_tables);
+  void updateElementIndexes();
+  template <typename T,
+    size_t MAX_SIZE,
+    size_t N,
+    size_t INDEX_SIZE>
+  static void updateElementIndex(Array<T *,MAX_SIZE> & element_ptrs,
+    ConcatenatedArray<T,N> & elements,
+    HashIndex<INDEX_SIZE> & name_index);
+  template <typename T,
+    size_t MAX_SIZE,
+    size_t N,
+    size_t INDEX_SIZE>
+  static void updateElementIndex(Array<T *,MAX_SIZE> & element_ptrs,
+    ConcatenatedArray<T,N> & elements,
+    ElementTableIndex<MAX_SIZE> & table_index,
+    HashIndex<INDEX_SIZE> & name_index);
+  template <typename T,
+    typename U,
+    size_t MAX_SIZE,
+    size_t N,
+    size_t INDEX_SIZE>
+  static int findElementIndex(Array<U *,MAX_SIZE> & element_ptrs,
+    ConcatenatedArray<U,N> & elements,
+    HashIndex<INDEX_SIZE> & name_index,
+    T const & name);
+  template <typename T,
+    typename U,
+    size_t MAX_SIZE,
+    size_t N,
+    size_t INDEX_SIZE>
+  static int findElementIndex(Array<U *,MAX_SIZE> & element_ptrs,
+    ConcatenatedArray<U,N> & elements,
+    ElementTableIndex<MAX_SIZE> & table_index,
+    HashIndex<INDEX_SIZE> & name_index,
+    T const & name);
+  template <typename T>
+  static const ConstantString & getElementName(T & element);
+  static const ConstantString & getElementName(Property & property);
+  template <typename T,
+    typename U>
+  static bool compareElementName(U & element,
+    T const & name);
+  template <typename T>
+  static bool compareElementName(Property & property,
+    T const & name);
+  Pin & pinAt(size_t pin_index);
+  Property & propertyAt(size_t property_index);
+  Parameter & parameterAt(size_t parameter_index);
+  Function & functionAt(size_t function_index);
+  Callback & callbackAt(size_t callback_index);
   template <typename T>
   int findPinIndex(T const & pin_name);
   ArduinoJson::JsonVariant getParameterValue(const ConstantString & parameter_name);
@@ -150,6 +265,17 @@ private:
   void processRequestArray();
   int findMethodIndex(const char * method_string);
   int findMethodIndex(int method_id);
+  int lookupMethodIndex(const char * method_name);
+  size_t getMethodCount();
+  const ConstantString & getMethodName(size_t method_index);
+  bool compareMethodName(size_t method_index,
+    const char * method_name);
+  void updateMethodIndex();
+  void buildMethodIndex();
+  bool stableMethodIds();
+  int getMethodId(size_t method_index);
+  int findMethodIndexByStableId(uint16_t method_id);
+  int findStableIdOwner(uint16_t method_id);
   template <typename T>
   int findPropertyIndex(T const & property_name);
   template <typename T>
@@ -161,17 +287,24 @@ private:
   int findFunctionIndex(T const & function_name);
   template <typename T>
   int findCallbackIndex(T const & callback_name);
+  template <typename T>
+  int findMethodFunctionIndex(T & method,
+    size_t element_index);
   int processParameterString(Function & function,
     const char * parameter_string);
+  int processParameterElement(Function & function,
+    size_t element_index);
   bool checkParameters(Function & function,
     size_t request_array_start_index);
+  void clearArguments(Function & function);
+  bool callFunction(Function & function);
   bool checkParameter(Parameter & parameter,
-    ArduinoJson::JsonVariant json_value);
-  bool checkArrayParameterElement(Parameter & parameter,
-    ArduinoJson::JsonVariant json_value);
+    ArduinoJson::JsonVariant json_value,
+    Argument & argument);
   long getSerialNumber();
   void initializeEeprom();
   void incrementServerStream();
+  void processRequest(ServerStream & server_stream);
   void help(bool verbose);
   void writeDeviceIdToResponse();
   void writeAncestorsToResponse(ArduinoJson::JsonArray firmware_name_array);
@@ -181,11 +314,39 @@ private:
   void writePinInfoToResponse(const ConstantString & pin_name);
   void writeApiToResponse(const ConstantString & verbosity,
     ArduinoJson::JsonArray firmware_name_array);
+  void writeApiObjectToResponse(const ConstantString & verbosity,
+    ArduinoJson::JsonArray firmware_name_array,
+    constants::FirmwareMask firmware_mask);
+  size_t writeApiMembersToResponse(const ConstantString & verbosity,
+    ArduinoJson::JsonArray firmware_name_array,
+    constants::FirmwareMask firmware_mask,
+    size_t cursor,
+    size_t page_size);
+  bool apiElementInPage(size_t & position,
+    size_t cursor,
+    size_t page_end,
+    bool & section_begun,
+    const ConstantString & section_key);
+  void endApiSection(bool section_begun);
+  void writeCursorToResponse(size_t next_cursor);
+  bool apiCacheable(const ConstantString & verbosity,
+    ArduinoJson::JsonArray firmware_name_array,
+    constants::FirmwareMask firmware_mask);
+  void apiChanged();
+  void resultsChanged();
+  void propertyValueChanged(Property & property);
+  void updateApiHashes();
+  uint32_t getApiHash(const ConstantString & verbosity,
+    ArduinoJson::JsonArray firmware_name_array);
+  uint32_t computeApiHash(const ConstantString & verbosity,
+    ArduinoJson::JsonArray firmware_name_array,
+    constants::FirmwareMask firmware_mask);
+  int getApiHashIndex(const ConstantString & verbosity,
+    ArduinoJson::JsonArray firmware_name_array,
+    constants::FirmwareMask firmware_mask);
+  const ConstantString * findVerbosityPtr(const char * verbosity);
   bool containsAllOrMoreThanOne(ArduinoJson::JsonArray firmware_name_array);
-  size_t getPropertiesCount(ArduinoJson::JsonArray firmware_name_array);
-  size_t getParametersCount(ArduinoJson::JsonArray firmware_name_array);
-  size_t getFunctionsCount(ArduinoJson::JsonArray firmware_name_array);
-  size_t getCallbacksCount(ArduinoJson::JsonArray firmware_name_array);
+  constants::FirmwareMask getFirmwareMask(ArduinoJson::JsonArray firmware_name_array);
   void versionToString(char * destination,
     long major,
     long minor,
@@ -211,14 +372,19 @@ private:
   void getDeviceIdHandler();
   void getDeviceInfoHandler();
   void getApiHandler();
+  void getApiHashHandler();
+  void getApiIfChangedHandler();
+  void getApiPageHandler();
   void getMemoryFreeHandler();
   void getPropertyDefaultValuesHandler();
   void getPropertyValuesHandler();
+  void getPropertyValuesPageHandler();
   void setPropertiesToDefaultsHandler();
   void getPinInfoHandler();
   void setPinModeHandler();
   void getPinValueHandler();
   void setPinValueHandler();
+  void getFunctionIdsHandler();
 
 };
 }
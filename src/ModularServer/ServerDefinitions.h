@@ -24,6 +24,7 @@ void Server::addHardware(const constants::HardwareInfo & hardware_info,
 {
   hardware_info_array_.push_back(&hardware_info);
   pins_.addArray(pins);
+  apiChanged();
 }
 
 // Pins
@@ -51,6 +52,26 @@ void Server::addFirmware(const constants::FirmwareInfo & firmware_info,
   parameters_.addArray(parameters);
   functions_.addArray(functions);
   callbacks_.addArray(callbacks);
+  apiChanged();
+}
+
+template <size_t PROPERTIES_MAX_SIZE,
+  size_t PARAMETERS_MAX_SIZE,
+  size_t FUNCTIONS_MAX_SIZE,
+  size_t CALLBACKS_MAX_SIZE>
+void Server::addFirmware(const constants::FirmwareInfo & firmware_info,
+  Property (&properties)[PROPERTIES_MAX_SIZE],
+  Parameter (&parameters)[PARAMETERS_MAX_SIZE],
+  Function (&functions)[FUNCTIONS_MAX_SIZE],
+  Callback (&callbacks)[CALLBACKS_MAX_SIZE],
+  const constants::ElementTables & element_tables)
+{
+  addFirmware(firmware_info,
+    properties,
+    parameters,
+    functions,
+    callbacks);
+  addElementTables(element_tables);
 }
 
 // Properties
@@ -65,6 +86,7 @@ Property & Server::createProperty(const ConstantString & property_name,
         default_value));
     const ConstantString * firmware_name_ptr = firmware_info_array_.back()->name_ptr;
     properties_.back().parameter().setFirmwareName(*firmware_name_ptr);
+    properties_.back().parameter().setFirmwareIndex(firmware_info_array_.size() - 1);
     return properties_.back();
   }
   return properties_[0]; // bad reference
@@ -82,17 +104,48 @@ Property & Server::createProperty(const ConstantString & property_name,
         default_value));
     const ConstantString * firmware_name_ptr = firmware_info_array_.back()->name_ptr;
     properties_.back().parameter().setFirmwareName(*firmware_name_ptr);
+    properties_.back().parameter().setFirmwareIndex(firmware_info_array_.size() - 1);
     return properties_.back();
   }
   return properties_[0]; // bad reference
 }
 
+template <typename T>
+Property & Server::createProperty(const ConstantString & property_name,
+  const T & default_value,
+  PropertyHandle<T> & property_handle)
+{
+  // the handle and default value share T, so a handle of the wrong type or
+  // array length does not compile. The handle is only bound to a property
+  // with the requested name, never to the bad reference
+  Property & property = createProperty(property_name,default_value);
+  if (property.parameter().compareName(property_name))
+  {
+    property_handle = PropertyHandle<T>(property);
+  }
+  return property;
+}
+
+template <typename T,
+  size_t N>
+Property & Server::createProperty(const ConstantString & property_name,
+  const T (&default_value)[N],
+  PropertyHandle<T[N]> & property_handle)
+{
+  Property & property = createProperty(property_name,default_value);
+  if (property.parameter().compareName(property_name))
+  {
+    property_handle = PropertyHandle<T[N]>(property);
+  }
+  return property;
+}
+
 template <typename T>
 void Server::setPropertiesToDefaults(T & firmware_name_array)
 {
   for (size_t i=0; i<properties_.size(); ++i)
   {
-    Property & property = properties_[i];
+    Property & property = propertyAt(i);
     if (property.parameter().firmwareNameInArray(firmware_name_array))
     {
       property.setValueToDefault();
@@ -109,49 +162,155 @@ void Server::setPropertiesToDefaults(T & firmware_name_array)
 // Response
 
 // private
-template <typename T>
-int Server::findPinIndex(T const & pin_name)
+template <typename T,
+  size_t MAX_SIZE,
+  size_t N,
+  size_t INDEX_SIZE>
+void Server::updateElementIndex(Array<T *,MAX_SIZE> & element_ptrs,
+  ConcatenatedArray<T,N> & elements,
+  HashIndex<INDEX_SIZE> & name_index)
 {
-  int pin_index = -1;
-  for (size_t i=0; i<pins_.size(); ++i)
+  // elements are only ever appended, so only new elements need indexing
+  size_t element_count = elements.size();
+  if (element_count > MAX_SIZE)
+  {
+    element_count = MAX_SIZE;
+  }
+  for (size_t i=element_ptrs.size(); i<element_count; ++i)
   {
-    if (pins_[i].compareName(pin_name))
+    // an element left out of the name index must also stay out of the flat
+    // index, so it is still found by the search past the flat index
+    if (!name_index.insert(NamedElement::hashName(getElementName(elements[i])),i))
     {
-      pin_index = i;
-      break;
+      return;
     }
+    element_ptrs.push_back(&elements[i]);
   }
-  return pin_index;
 }
 
-template <typename T>
-int Server::findPropertyIndex(T const & property_name)
+template <typename T,
+  size_t MAX_SIZE,
+  size_t N,
+  size_t INDEX_SIZE>
+void Server::updateElementIndex(Array<T *,MAX_SIZE> & element_ptrs,
+  ConcatenatedArray<T,N> & elements,
+  ElementTableIndex<MAX_SIZE> & table_index,
+  HashIndex<INDEX_SIZE> & name_index)
 {
-  int property_index = -1;
-  for (size_t i=0; i<properties_.size(); ++i)
+  // elements named in the flash tables only take a byte of ram each, the
+  // rest go to the ram hash index
+  size_t element_count = elements.size();
+  if (element_count > MAX_SIZE)
   {
-    if (properties_[i].parameter().compareName(property_name))
+    element_count = MAX_SIZE;
+  }
+  for (size_t i=element_ptrs.size(); i<element_count; ++i)
+  {
+    uint32_t hash = NamedElement::hashName(getElementName(elements[i]));
+    if (!table_index.insert(hash,i) && !name_index.insert(hash,i))
     {
-      property_index = i;
-      break;
+      return;
     }
+    element_ptrs.push_back(&elements[i]);
   }
-  return property_index;
 }
 
-template <typename T>
-int Server::findParameterIndex(T const & parameter_name)
+template <typename T,
+  typename U,
+  size_t MAX_SIZE,
+  size_t N,
+  size_t INDEX_SIZE>
+int Server::findElementIndex(Array<U *,MAX_SIZE> & element_ptrs,
+  ConcatenatedArray<U,N> & elements,
+  HashIndex<INDEX_SIZE> & name_index,
+  T const & name)
 {
-  int parameter_index = -1;
-  for (size_t i=0; i<parameters_.size(); ++i)
+  // keeping the name index current as elements are created makes each
+  // create and lookup constant time instead of a scan over every element
+  updateElementIndex(element_ptrs,elements,name_index);
+  uint32_t hash = NamedElement::hashName(name);
+  size_t probe = 0;
+  int element_index;
+  while ((element_index = name_index.find(hash,probe)) >= 0)
   {
-    if (parameters_[i].compareName(parameter_name))
+    if (compareElementName(*element_ptrs[element_index],name))
     {
-      parameter_index = i;
-      break;
+      return element_index;
     }
   }
-  return parameter_index;
+  // elements past the flat index are only found by searching
+  for (size_t i=element_ptrs.size(); i<elements.size(); ++i)
+  {
+    if (compareElementName(elements[i],name))
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+template <typename T,
+  typename U,
+  size_t MAX_SIZE,
+  size_t N,
+  size_t INDEX_SIZE>
+int Server::findElementIndex(Array<U *,MAX_SIZE> & element_ptrs,
+  ConcatenatedArray<U,N> & elements,
+  ElementTableIndex<MAX_SIZE> & table_index,
+  HashIndex<INDEX_SIZE> & name_index,
+  T const & name)
+{
+  updateElementIndex(element_ptrs,elements,table_index,name_index);
+  uint32_t hash = NamedElement::hashName(name);
+  size_t probe = 0;
+  int element_index;
+  while ((element_index = table_index.find(hash,probe)) >= 0)
+  {
+    if (compareElementName(*element_ptrs[element_index],name))
+    {
+      return element_index;
+    }
+  }
+  return findElementIndex(element_ptrs,elements,name_index,name);
+}
+
+template <typename T>
+const ConstantString & Server::getElementName(T & element)
+{
+  return element.getName();
+}
+
+template <typename T,
+  typename U>
+bool Server::compareElementName(U & element,
+  T const & name)
+{
+  return element.compareName(name);
+}
+
+template <typename T>
+bool Server::compareElementName(Property & property,
+  T const & name)
+{
+  return property.parameter().compareName(name);
+}
+
+template <typename T>
+int Server::findPinIndex(T const & pin_name)
+{
+  return findElementIndex(pin_ptrs_,pins_,pin_name_index_,pin_name);
+}
+
+template <typename T>
+int Server::findPropertyIndex(T const & property_name)
+{
+  return findElementIndex(property_ptrs_,properties_,property_table_index_,property_name_index_,property_name);
+}
+
+template <typename T>
+int Server::findParameterIndex(T const & parameter_name)
+{
+  return findElementIndex(parameter_ptrs_,parameters_,parameter_table_index_,parameter_name_index_,parameter_name);
 }
 
 template <typename T>
@@ -175,31 +334,32 @@ int Server::findFunctionParameterIndex(Function & function,
 template <typename T>
 int Server::findFunctionIndex(T const & function_name)
 {
-  int function_index = -1;
-  for (size_t i=0; i<functions_.size(); ++i)
-  {
-    if (functions_[i].compareName(function_name))
-    {
-      function_index = i;
-      break;
-    }
-  }
-  return function_index;
+  return findElementIndex(function_ptrs_,functions_,function_table_index_,function_name_index_,function_name);
 }
 
 template <typename T>
 int Server::findCallbackIndex(T const & callback_name)
 {
-  int callback_index = -1;
-  for (size_t i=0; i<callbacks_.size(); ++i)
+  return findElementIndex(callback_ptrs_,callbacks_,callback_table_index_,callback_name_index_,callback_name);
+}
+
+template <typename T>
+int Server::findMethodFunctionIndex(T & method,
+  size_t element_index)
+{
+  // an integer addresses the function by its position in the function table
+  ArduinoJson::JsonVariant element = request_json_array_[element_index];
+  if (element.is<long>())
   {
-    if (callbacks_[i].compareName(callback_name))
+    long function_id = element.as<long>();
+    if ((function_id >= 0) && (function_id < (long)method.functions_.size()))
     {
-      callback_index = i;
-      break;
+      return function_id;
     }
+    return -1;
   }
-  return callback_index;
+  const char * function_name = getRequestElementAsString(element_index,request_json_array_.size());
+  return method.findFunctionIndex(function_name);
 }
 
 }
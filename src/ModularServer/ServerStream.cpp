@@ -0,0 +1,350 @@
+// ----------------------------------------------------------------------------
+// ServerStream.cpp
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#include "ServerStream.h"
+
+
+namespace modular_server
+{
+// public
+ServerStream::ServerStream()
+{
+  stream_ptr_ = NULL;
+  setup();
+}
+
+void ServerStream::setByteBudget(size_t byte_budget)
+{
+  if (byte_budget > 0)
+  {
+    byte_budget_ = byte_budget;
+  }
+}
+
+size_t ServerStream::getByteBudget()
+{
+  return byte_budget_;
+}
+
+void ServerStream::setWeight(size_t weight)
+{
+  if (weight > 0)
+  {
+    weight_ = weight;
+  }
+}
+
+size_t ServerStream::getWeight()
+{
+  return weight_;
+}
+
+size_t ServerStream::getQueueDepth()
+{
+  // bytes received but not yet served
+  size_t queue_depth = request_length_;
+  if (stream_ptr_)
+  {
+    int available = stream_ptr_->available();
+    if (available > 0)
+    {
+      queue_depth += available;
+    }
+  }
+  return queue_depth;
+}
+
+unsigned long ServerStream::getServedRequestCount()
+{
+  return served_request_count_;
+}
+
+void ServerStream::setOutputBufferSize(size_t output_buffer_size)
+{
+  transmitBlocking(output_length_);
+  if (output_buffer_size > constants::SERVER_STREAM_OUTPUT_BUFFER_SIZE_MAX)
+  {
+    output_buffer_size = constants::SERVER_STREAM_OUTPUT_BUFFER_SIZE_MAX;
+  }
+  output_buffer_size_ = output_buffer_size;
+  output_head_ = 0;
+}
+
+size_t ServerStream::getOutputBufferSize()
+{
+  return output_buffer_size_;
+}
+
+unsigned long ServerStream::getOutputByteCount()
+{
+  return output_byte_count_;
+}
+
+unsigned long ServerStream::getOutputFlushCount()
+{
+  return output_flush_count_;
+}
+
+size_t ServerStream::getOutputFlushSizeAverage()
+{
+  if (output_flush_count_ == 0)
+  {
+    return 0;
+  }
+  return output_byte_count_ / output_flush_count_;
+}
+
+size_t ServerStream::getOutputQueueLength()
+{
+  return output_length_;
+}
+
+size_t ServerStream::getOutputQueueLengthMax()
+{
+  return output_length_max_;
+}
+
+unsigned long ServerStream::getOutputStallCount()
+{
+  return output_stall_count_;
+}
+
+unsigned long ServerStream::getOutputStallTime()
+{
+  return output_stall_time_;
+}
+
+size_t ServerStream::write(uint8_t byte)
+{
+  return write(&byte,1);
+}
+
+size_t ServerStream::write(const uint8_t * buffer,
+  size_t size)
+{
+  if (!stream_ptr_)
+  {
+    return 0;
+  }
+  if (output_buffer_size_ == 0)
+  {
+    writeOutput(buffer,size);
+    return size;
+  }
+  size_t written = 0;
+  while (written < size)
+  {
+    if (output_length_ >= output_buffer_size_)
+    {
+      makeRoom(size - written);
+    }
+    size_t tail = (output_head_ + output_length_) % output_buffer_size_;
+    size_t chunk = min(size - written,output_buffer_size_ - output_length_);
+    chunk = min(chunk,output_buffer_size_ - tail);
+    memcpy(output_buffer_ + tail,buffer + written,chunk);
+    output_length_ += chunk;
+    written += chunk;
+  }
+  if (output_length_ > output_length_max_)
+  {
+    output_length_max_ = output_length_;
+  }
+  return size;
+}
+
+int ServerStream::available()
+{
+  if (!stream_ptr_)
+  {
+    return 0;
+  }
+  return stream_ptr_->available();
+}
+
+int ServerStream::read()
+{
+  if (!stream_ptr_)
+  {
+    return -1;
+  }
+  return stream_ptr_->read();
+}
+
+int ServerStream::peek()
+{
+  if (!stream_ptr_)
+  {
+    return -1;
+  }
+  return stream_ptr_->peek();
+}
+
+void ServerStream::flush()
+{
+  transmit();
+  if (!output_room_reported_)
+  {
+    // the underlying stream cannot say when it has room, so the ring can
+    // not drain in the background
+    transmitBlocking(output_length_);
+  }
+}
+
+// private
+ServerStream::ServerStream(Stream & stream)
+{
+  stream_ptr_ = &stream;
+  setup();
+}
+
+Stream & ServerStream::getStream()
+{
+  return *stream_ptr_;
+}
+
+bool ServerStream::readAvailable()
+{
+  // Only take bytes already received, at most byte_budget_ per call, so a
+  // slow sender never holds up the main loop
+  size_t bytes_left = byte_budget_;
+  while (!request_complete_ && (bytes_left > 0) && (stream_ptr_->available() > 0))
+  {
+    int c = stream_ptr_->read();
+    if (c < 0)
+    {
+      break;
+    }
+    --bytes_left;
+    if (c == JsonStream::EOL)
+    {
+      request_[request_length_] = '\0';
+      request_complete_ = true;
+    }
+    else if (request_length_ < (constants::STRING_LENGTH_REQUEST - 1))
+    {
+      request_[request_length_++] = c;
+    }
+    else
+    {
+      request_overflow_ = true;
+    }
+  }
+  return request_complete_;
+}
+
+bool ServerStream::requestComplete()
+{
+  return request_complete_;
+}
+
+bool ServerStream::requestOverflow()
+{
+  return request_overflow_;
+}
+
+char * ServerStream::getRequest()
+{
+  return request_;
+}
+
+void ServerStream::setup()
+{
+  byte_budget_ = constants::server_stream_byte_budget_default;
+  weight_ = constants::server_stream_weight_default;
+  served_request_count_ = 0;
+  output_buffer_size_ = constants::server_stream_output_buffer_size_default;
+  output_head_ = 0;
+  output_length_ = 0;
+  output_length_max_ = 0;
+  output_room_reported_ = false;
+  output_byte_count_ = 0;
+  output_flush_count_ = 0;
+  output_stall_count_ = 0;
+  output_stall_time_ = 0;
+  clearRequest();
+}
+
+void ServerStream::clearRequest()
+{
+  request_[0] = '\0';
+  request_length_ = 0;
+  request_complete_ = false;
+  request_overflow_ = false;
+}
+
+bool ServerStream::outputReady()
+{
+  // stop taking requests while a slow reader leaves the ring over half full
+  return (output_length_ <= (output_buffer_size_ / 2));
+}
+
+void ServerStream::transmit()
+{
+  if (!stream_ptr_)
+  {
+    return;
+  }
+  while (output_length_ > 0)
+  {
+    int room = stream_ptr_->availableForWrite();
+    if (room <= 0)
+    {
+      break;
+    }
+    output_room_reported_ = true;
+    size_t chunk = min((size_t)room,output_length_);
+    chunk = min(chunk,output_buffer_size_ - output_head_);
+    writeOutput(output_buffer_ + output_head_,chunk);
+    output_head_ = (output_head_ + chunk) % output_buffer_size_;
+    output_length_ -= chunk;
+  }
+  if (output_length_ == 0)
+  {
+    output_head_ = 0;
+  }
+}
+
+void ServerStream::transmitBlocking(size_t size)
+{
+  while ((size > 0) && (output_length_ > 0))
+  {
+    size_t chunk = min(size,output_length_);
+    chunk = min(chunk,output_buffer_size_ - output_head_);
+    writeOutput(output_buffer_ + output_head_,chunk);
+    output_head_ = (output_head_ + chunk) % output_buffer_size_;
+    output_length_ -= chunk;
+    size -= chunk;
+  }
+  if (output_length_ == 0)
+  {
+    output_head_ = 0;
+  }
+}
+
+void ServerStream::makeRoom(size_t size)
+{
+  transmit();
+  if (output_length_ < output_buffer_size_)
+  {
+    return;
+  }
+  // one response is larger than the ring, so the handler has to wait
+  unsigned long stall_start = micros();
+  transmitBlocking(min(size,output_buffer_size_));
+  output_stall_time_ += micros() - stall_start;
+  ++output_stall_count_;
+}
+
+void ServerStream::writeOutput(const uint8_t * buffer,
+  size_t size)
+{
+  stream_ptr_->write(buffer,size);
+  output_byte_count_ += size;
+  ++output_flush_count_;
+}
+
+}
@@ -0,0 +1,97 @@
+// ----------------------------------------------------------------------------
+// ServerStream.h
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_SERVER_STREAM_H_
+#define _MODULAR_SERVER_SERVER_STREAM_H_
+#include <Arduino.h>
+#include <JsonStream.h>
+
+#include "Constants.h"
+
+
+namespace modular_server
+{
+// Responses are written through the server stream into a transmit ring
+// that drains into the underlying stream only as fast as it reports room
+// with availableForWrite, so a slow reader does not block the main loop.
+// A handler only waits when a single response overflows the ring. Streams
+// that never report room are written in bulk when the response ends.
+// Reads pass straight through.
+class ServerStream : public Stream
+{
+public:
+  ServerStream();
+
+  void setByteBudget(size_t byte_budget);
+  size_t getByteBudget();
+  void setWeight(size_t weight);
+  size_t getWeight();
+  size_t getQueueDepth();
+  unsigned long getServedRequestCount();
+
+  // zero disables output buffering
+  void setOutputBufferSize(size_t output_buffer_size);
+  size_t getOutputBufferSize();
+  unsigned long getOutputByteCount();
+  unsigned long getOutputFlushCount();
+  size_t getOutputFlushSizeAverage();
+  size_t getOutputQueueLength();
+  size_t getOutputQueueLengthMax();
+  unsigned long getOutputStallCount();
+  unsigned long getOutputStallTime();
+
+  size_t write(uint8_t byte);
+  size_t write(const uint8_t * buffer,
+    size_t size);
+  using Print::write;
+  int available();
+  int read();
+  int peek();
+  // hands buffered output to the underlying stream as far as it has room,
+  // without waiting for it to be transmitted
+  void flush();
+
+private:
+  Stream * stream_ptr_;
+  char request_[constants::STRING_LENGTH_REQUEST];
+  size_t request_length_;
+  bool request_complete_;
+  bool request_overflow_;
+  size_t byte_budget_;
+  size_t weight_;
+  unsigned long served_request_count_;
+  uint8_t output_buffer_[constants::SERVER_STREAM_OUTPUT_BUFFER_SIZE_MAX];
+  size_t output_buffer_size_;
+  size_t output_head_;
+  size_t output_length_;
+  size_t output_length_max_;
+  bool output_room_reported_;
+  unsigned long output_byte_count_;
+  unsigned long output_flush_count_;
+  unsigned long output_stall_count_;
+  unsigned long output_stall_time_;
+
+  ServerStream(Stream & stream);
+  Stream & getStream();
+  bool readAvailable();
+  bool requestComplete();
+  bool requestOverflow();
+  char * getRequest();
+  void clearRequest();
+  void setup();
+  bool outputReady();
+  void transmit();
+  void transmitBlocking(size_t size);
+  void makeRoom(size_t size);
+  void writeOutput(const uint8_t * buffer,
+    size_t size);
+
+  friend class Server;
+};
+}
+
+#endif
@@ -0,0 +1,139 @@
+// ----------------------------------------------------------------------------
+// SubsetIndex.cpp
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#include "SubsetIndex.h"
+
+
+namespace modular_server
+{
+// public
+SubsetIndex::SubsetIndex()
+{
+  clear();
+}
+
+// private
+void SubsetIndex::clear()
+{
+  hash_index_.clear();
+  subset_data_ = NULL;
+  subset_size_ = 0;
+  strings_ = false;
+  complete_ = false;
+}
+
+void SubsetIndex::build(Vector<constants::SubsetMemberType> & subset,
+  bool strings)
+{
+  clear();
+  strings_ = strings;
+  for (size_t i=0; i<subset.size(); ++i)
+  {
+    if (!insert(subset[i],i))
+    {
+      // table too small, leave the subset to the linear search
+      clear();
+      return;
+    }
+  }
+  subset_data_ = getData(subset);
+  subset_size_ = subset.size();
+  complete_ = true;
+}
+
+bool SubsetIndex::append(Vector<constants::SubsetMemberType> & subset,
+  bool strings)
+{
+  // only a single value pushed onto the storage already indexed can be
+  // added in place, anything else needs a rebuild
+  if (!complete_ ||
+    (strings_ != strings) ||
+    (subset.size() != (subset_size_ + 1)) ||
+    ((subset_size_ > 0) && (getData(subset) != subset_data_)))
+  {
+    return false;
+  }
+  if (!insert(subset.back(),subset_size_))
+  {
+    clear();
+    return true;
+  }
+  subset_data_ = getData(subset);
+  subset_size_ = subset.size();
+  return true;
+}
+
+bool SubsetIndex::indexes(Vector<constants::SubsetMemberType> & subset,
+  bool strings)
+{
+  return (complete_ &&
+    (strings_ == strings) &&
+    (subset.size() == subset_size_) &&
+    (getData(subset) == subset_data_));
+}
+
+int SubsetIndex::find(Vector<constants::SubsetMemberType> & subset,
+  long value)
+{
+  size_t probe = 0;
+  int member_index;
+  while ((member_index = hash_index_.find(hashValue(value),probe)) >= 0)
+  {
+    if (subset[member_index].l == value)
+    {
+      return member_index;
+    }
+  }
+  return -1;
+}
+
+int SubsetIndex::find(Vector<constants::SubsetMemberType> & subset,
+  const char * value)
+{
+  // the name hash is case folded, the comparison is not
+  size_t probe = 0;
+  int member_index;
+  while ((member_index = hash_index_.find(NamedElement::hashName(value),probe)) >= 0)
+  {
+    if (value == *subset[member_index].cs_ptr)
+    {
+      return member_index;
+    }
+  }
+  return -1;
+}
+
+bool SubsetIndex::insert(constants::SubsetMemberType & member,
+  size_t member_index)
+{
+  uint32_t hash;
+  if (strings_)
+  {
+    hash = NamedElement::hashName(*member.cs_ptr);
+  }
+  else
+  {
+    hash = hashValue(member.l);
+  }
+  return hash_index_.insert(hash,member_index);
+}
+
+uint32_t SubsetIndex::hashValue(long value)
+{
+  return (uint32_t)value * constants::method_id_hash_multiplier;
+}
+
+const constants::SubsetMemberType * SubsetIndex::getData(Vector<constants::SubsetMemberType> & subset)
+{
+  if (subset.size() == 0)
+  {
+    return NULL;
+  }
+  return &subset[0];
+}
+
+}
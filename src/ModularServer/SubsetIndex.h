@@ -0,0 +1,56 @@
+// ----------------------------------------------------------------------------
+// SubsetIndex.h
+//
+//
+// Authors:
+// Peter Polidoro peter@polidoro.io
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_SUBSET_INDEX_H_
+#define _MODULAR_SERVER_SUBSET_INDEX_H_
+#include <Arduino.h>
+#include <ConstantVariable.h>
+#include <Vector.h>
+
+#include "HashIndex.h"
+#include "NamedElement.h"
+#include "Constants.h"
+
+
+namespace modular_server
+{
+// Hash index over the members of a parameter subset. An index only answers
+// for the subset storage and size it was built from, so parameters copied
+// from the indexed parameter share it safely and fall back to a linear
+// search whenever the subset has changed underneath it.
+class SubsetIndex
+{
+public:
+  SubsetIndex();
+
+private:
+  HashIndex<constants::SUBSET_INDEX_SIZE> hash_index_;
+  const constants::SubsetMemberType * subset_data_;
+  size_t subset_size_;
+  bool strings_;
+  bool complete_;
+
+  void clear();
+  void build(Vector<constants::SubsetMemberType> & subset,
+    bool strings);
+  bool append(Vector<constants::SubsetMemberType> & subset,
+    bool strings);
+  bool indexes(Vector<constants::SubsetMemberType> & subset,
+    bool strings);
+  int find(Vector<constants::SubsetMemberType> & subset,
+    long value);
+  int find(Vector<constants::SubsetMemberType> & subset,
+    const char * value);
+  bool insert(constants::SubsetMemberType & member,
+    size_t member_index);
+  static uint32_t hashValue(long value);
+  static const constants::SubsetMemberType * getData(Vector<constants::SubsetMemberType> & subset);
+  friend class Parameter;
+};
+}
+
+#endif
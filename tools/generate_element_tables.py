@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""Generate flash element tables from a modular device api file.
+
+The api file is the result of getApi with GENERAL or NAMES verbosity, as
+saved in api/*.json. Each element name is hashed the same way as
+NamedElement::hashName and the hashes are written out sorted, so the server
+finds names with a binary search over flash instead of a hash index in ram.
+
+usage: generate_element_tables.py API_FILE OUTPUT_FILE [--namespace NAMESPACE]
+"""
+import argparse
+import json
+import os
+import re
+
+
+SECTIONS = (
+    ('properties', 'property'),
+    ('parameters', 'parameter'),
+    ('functions', 'function'),
+    ('callbacks', 'callback'),
+)
+
+LIBRARY_NAMESPACE = 'modular_server::constants'
+
+
+def hash_name(name):
+    # FNV-1a over the case folded name, as NamedElement::hashName
+    value = 2166136261
+    for c in name.encode('ascii'):
+        if ord('A') <= c <= ord('Z'):
+            c += ord('a') - ord('A')
+        value ^= c
+        value = (value * 16777619) & 0xFFFFFFFF
+    return value
+
+
+def element_name(element):
+    if isinstance(element, dict):
+        return element['name']
+    return element
+
+
+def read_api(api_path):
+    with open(api_path) as api_file:
+        api = json.load(api_file)
+    result = api.get('result', api)
+    firmware = result['firmware'][0]
+    return element_name(firmware), result
+
+
+def upper_snake(name):
+    return re.sub(r'(?<=[a-z0-9])(?=[A-Z])', '_', name).upper()
+
+
+def write_tables(api_path, output_path, namespace):
+    firmware_name, api = read_api(api_path)
+    library = (namespace == LIBRARY_NAMESPACE)
+    if library:
+        guard = '_MODULAR_SERVER_ELEMENT_TABLES_H_'
+        tables_type = 'ElementTables'
+    else:
+        guard = upper_snake(firmware_name) + '_ELEMENT_TABLES_H'
+        tables_type = 'modular_server::ElementTables'
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    api_name = os.path.relpath(os.path.abspath(api_path), root)
+    script_name = os.path.relpath(os.path.abspath(__file__), root)
+
+    lines = []
+    lines.append('// ' + '-' * 76)
+    lines.append('// ' + os.path.basename(output_path))
+    lines.append('//')
+    lines.append('// Generated from {0}'.format(api_name))
+    lines.append('// by {0}, do not edit.'.format(script_name))
+    lines.append('//')
+    lines.append('// Authors:')
+    lines.append('// Peter Polidoro peter@polidoro.io')
+    lines.append('// ' + '-' * 76)
+    lines.append('#ifndef ' + guard)
+    lines.append('#define ' + guard)
+    lines.append('#include "Constants.h"')
+    lines.append('')
+    lines.append('')
+    namespaces = namespace.split('::')
+    for name in namespaces:
+        lines.append('namespace ' + name)
+        lines.append('{')
+
+    members = []
+    for section, singular in SECTIONS:
+        names = [element_name(element) for element in api.get(section, [])]
+        if not names:
+            members.append(('NULL', 0))
+            continue
+        array_name = singular + '_name_hashes'
+        lines.append('const uint32_t {0}[] PROGMEM ='.format(array_name))
+        lines.append('{')
+        entries = sorted((hash_name(name), name) for name in names)
+        for index, (value, name) in enumerate(entries):
+            separator = ',' if index < (len(entries) - 1) else ''
+            lines.append('  0x{0:08X}UL{1} // {2}'.format(value, separator, name))
+        lines.append('};')
+        lines.append('')
+        members.append((array_name, len(entries)))
+
+    lines.append('const {0} element_tables ='.format(tables_type))
+    lines.append('{')
+    for index, (array_name, count) in enumerate(members):
+        separator = ',' if index < (len(members) - 1) else ''
+        lines.append('  {0},'.format(array_name))
+        lines.append('  {0}{1}'.format(count, separator))
+    lines.append('};')
+    for name in namespaces:
+        lines.append('}')
+    lines.append('#endif')
+
+    with open(output_path, 'w') as output_file:
+        output_file.write('\n'.join(lines) + '\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('api_file')
+    parser.add_argument('output_file')
+    parser.add_argument('--namespace', default='constants')
+    args = parser.parse_args()
+    write_tables(args.api_file, args.output_file, args.namespace)
+
+
+if __name__ == '__main__':
+    main()